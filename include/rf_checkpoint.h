@@ -0,0 +1,291 @@
+#pragma once
+
+// RTLflow: checkpoints of a whole batch
+//
+// A checkpoint holds the signal pools of every stimulus, the change and
+// done vectors, and a header with the pool sizes of the generated model,
+// which restoring checks. A batch can be restored whole, for a subset of
+// its stimuli, or from one saved stimulus broadcast into any number of
+// stimuli, from a checkpoint of a batch of another size.
+//
+//   RfCheckpointHeader
+//   CData pool, SData pool, IData pool, QData pool  (rows * stimuli each)
+//   bit planes                                      (rows * (stimuli + 63) / 64)
+//   change, done                                    (stimuli each)
+//
+// Copying one stimulus needs the layout of the pools: a signal of stride
+// elements per stimulus at pool row memLoc holds stimulus i at element
+// memLoc * stimuli + i * stride. The generated model describes its pools
+// as RfSegments of signals of equal stride placed back to back.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rf_heavy.h"
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+const char RF_CHECKPOINT_MAGIC[8] = {'R', 'F', 'C', 'K', 'P', 'T', '0', '1'};
+
+enum RfPool : uint32_t {
+    RF_POOL_C = 0,
+    RF_POOL_S = 1,
+    RF_POOL_I = 2,
+    RF_POOL_Q = 3,
+    RF_POOL_B = 4  ///< Bit planes
+};
+
+const size_t RF_POOL_BYTES[] = {sizeof(CData), sizeof(SData), sizeof(IData), sizeof(QData),
+                                sizeof(QData)};
+
+// count signals of stride elements per stimulus, from pool row memLoc on
+struct RfSegment final {
+    uint32_t pool;  ///< RfPool, not RF_POOL_B
+    uint32_t stride;  ///< Elements per stimulus of each signal
+    size_t memLoc;  ///< Row of the first signal
+    size_t count;  ///< Signals
+};
+
+// The state of a batch: the pools, with rows[RF_POOL_B] bit planes
+struct RfBatch final {
+    void* pools[5];
+    size_t rows[5];
+    IData* change;
+    bool* done;
+    size_t stimuli;
+    size_t poolBytes(uint32_t pool) const {
+        return pool == RF_POOL_B ? rows[pool] * ((stimuli + 63) / 64) * sizeof(QData)
+                                 : rows[pool] * stimuli * RF_POOL_BYTES[pool];
+    }
+};
+
+// Set stimuli [begin, end) of dst to stimulus from of src, which may be
+// dst itself. Runs row by row, so each row of a stride 1 signal is one fill
+template <typename T>
+void rfBroadcastRows(T* dstp, size_t dstStimuli, size_t begin, size_t end, const T* srcp,
+                     size_t srcStimuli, size_t from, const RfSegment& seg) {
+    for (size_t i = 0; i < seg.count; ++i) {
+        const size_t row = seg.memLoc + i * seg.stride;
+        T* const dstRowp = dstp + row * dstStimuli;
+        const T* const srcRowp = srcp + row * srcStimuli + from * seg.stride;
+        if (seg.stride == 1) {
+            const T value = *srcRowp;
+            std::fill(dstRowp + begin, dstRowp + end, value);
+            continue;
+        }
+        for (size_t lane = begin; lane < end; ++lane) {
+            if (dstRowp + lane * seg.stride == srcRowp) continue;
+            std::memcpy(dstRowp + lane * seg.stride, srcRowp, seg.stride * sizeof(T));
+        }
+    }
+}
+
+inline void rfBroadcastLane(const RfBatch& dst, size_t begin, size_t end, const RfBatch& src,
+                            size_t from, const RfSegment* segsp, size_t segCount) {
+    for (size_t s = 0; s < segCount; ++s) {
+        const RfSegment& seg = segsp[s];
+        switch (seg.pool) {
+        case RF_POOL_C:
+            rfBroadcastRows(static_cast<CData*>(dst.pools[RF_POOL_C]), dst.stimuli, begin, end,
+                            static_cast<const CData*>(src.pools[RF_POOL_C]), src.stimuli, from,
+                            seg);
+            break;
+        case RF_POOL_S:
+            rfBroadcastRows(static_cast<SData*>(dst.pools[RF_POOL_S]), dst.stimuli, begin, end,
+                            static_cast<const SData*>(src.pools[RF_POOL_S]), src.stimuli, from,
+                            seg);
+            break;
+        case RF_POOL_I:
+            rfBroadcastRows(static_cast<IData*>(dst.pools[RF_POOL_I]), dst.stimuli, begin, end,
+                            static_cast<const IData*>(src.pools[RF_POOL_I]), src.stimuli, from,
+                            seg);
+            break;
+        default:
+            rfBroadcastRows(static_cast<QData*>(dst.pools[RF_POOL_Q]), dst.stimuli, begin, end,
+                            static_cast<const QData*>(src.pools[RF_POOL_Q]), src.stimuli, from,
+                            seg);
+            break;
+        }
+    }
+    // Bit planes: whole words of the range at once
+    QData* const dstPlanesp = static_cast<QData*>(dst.pools[RF_POOL_B]);
+    const QData* const srcPlanesp = static_cast<const QData*>(src.pools[RF_POOL_B]);
+    for (size_t r = 0; r < dst.rows[RF_POOL_B]; ++r) {
+        QData* const planep = dstPlanesp + r * ((dst.stimuli + 63) / 64);
+        const QData value
+            = RF_BIT_GET(srcPlanesp + r * ((src.stimuli + 63) / 64), from) ? ~0ULL : 0ULL;
+        for (size_t w = begin / 64; w * 64 < end; ++w) {
+            const size_t lo = std::max(begin, w * 64) - w * 64;
+            const size_t hi = std::min(end, w * 64 + 64) - w * 64;
+            const QData mask = (hi == 64 ? ~0ULL : (1ULL << hi) - 1) & ~((1ULL << lo) - 1);
+            RF_WORD_SET(planep[w], mask, value);
+        }
+    }
+    const IData change = src.change[from];
+    const bool done = src.done[from];
+    std::fill(dst.change + begin, dst.change + end, change);
+    std::fill(dst.done + begin, dst.done + end, done);
+}
+
+struct RfCheckpointHeader final {
+    char magic[8];  ///< RF_CHECKPOINT_MAGIC
+    uint64_t stimuli;  ///< Stimuli of the saved batch
+    uint64_t rows[5];  ///< Pool sizes of the model, per stimulus
+    uint64_t init;  ///< Initial blocks have run
+};
+
+static_assert(sizeof(RfCheckpointHeader) == 64, "RfCheckpointHeader layout");
+
+class RfCheckpoint final {
+    const char* m_datap{nullptr};
+    size_t m_size{0};
+    RfBatch m_saved;  // Views into the mapped file
+
+public:
+    // Write the state of batch to path
+    static void save(const std::string& path, const RfBatch& batch, bool init) {
+        FILE* fp = std::fopen(path.c_str(), "wb");
+        if (!fp) throw std::runtime_error("RTLflow: cannot create " + path);
+        RfCheckpointHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, RF_CHECKPOINT_MAGIC, sizeof(RF_CHECKPOINT_MAGIC));
+        header.stimuli = batch.stimuli;
+        for (uint32_t p = 0; p < 5; ++p) header.rows[p] = batch.rows[p];
+        header.init = init;
+        bool ok = std::fwrite(&header, sizeof(header), 1, fp) == 1;
+        for (uint32_t p = 0; p < 5; ++p) {
+            const size_t bytes = batch.poolBytes(p);
+            if (bytes) ok = ok && std::fwrite(batch.pools[p], bytes, 1, fp) == 1;
+        }
+        ok = ok && std::fwrite(batch.change, sizeof(IData), batch.stimuli, fp) == batch.stimuli;
+        ok = ok && std::fwrite(batch.done, sizeof(bool), batch.stimuli, fp) == batch.stimuli;
+        ok = (std::fclose(fp) == 0) && ok;
+        if (!ok) throw std::runtime_error("RTLflow: cannot write " + path);
+    }
+
+    explicit RfCheckpoint(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("RTLflow: cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0
+            || static_cast<size_t>(st.st_size) < sizeof(RfCheckpointHeader)) {
+            ::close(fd);
+            throw std::runtime_error("RTLflow: truncated checkpoint " + path);
+        }
+        m_size = st.st_size;
+        void* mapp = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapp == MAP_FAILED) throw std::runtime_error("RTLflow: cannot map " + path);
+        m_datap = static_cast<const char*>(mapp);
+        const RfCheckpointHeader& h = header();
+        if (std::memcmp(h.magic, RF_CHECKPOINT_MAGIC, sizeof(RF_CHECKPOINT_MAGIC)) != 0) {
+            ::munmap(mapp, m_size);
+            throw std::runtime_error("RTLflow: not a checkpoint " + path);
+        }
+        m_saved.stimuli = h.stimuli;
+        size_t offset = sizeof(RfCheckpointHeader);
+        for (uint32_t p = 0; p < 5; ++p) {
+            m_saved.rows[p] = h.rows[p];
+            m_saved.pools[p] = const_cast<char*>(m_datap) + offset;
+            offset += m_saved.poolBytes(p);
+        }
+        m_saved.change = reinterpret_cast<IData*>(const_cast<char*>(m_datap) + offset);
+        offset += h.stimuli * sizeof(IData);
+        m_saved.done = reinterpret_cast<bool*>(const_cast<char*>(m_datap) + offset);
+        offset += h.stimuli * sizeof(bool);
+        if (offset > m_size) {
+            ::munmap(mapp, m_size);
+            throw std::runtime_error("RTLflow: truncated checkpoint " + path);
+        }
+    }
+    ~RfCheckpoint() { ::munmap(const_cast<char*>(m_datap), m_size); }
+    RfCheckpoint(const RfCheckpoint&) = delete;
+    RfCheckpoint& operator=(const RfCheckpoint&) = delete;
+
+    const RfCheckpointHeader& header() const {
+        return *reinterpret_cast<const RfCheckpointHeader*>(m_datap);
+    }
+    const RfBatch& saved() const { return m_saved; }
+
+    // Throw unless the checkpoint is of the model of batch, and, if
+    // sameStimuli, of a batch of as many stimuli
+    void check(const RfBatch& batch, bool sameStimuli) const {
+        for (uint32_t p = 0; p < 5; ++p) {
+            if (m_saved.rows[p] != batch.rows[p]) {
+                throw std::runtime_error("RTLflow: checkpoint of another model");
+            }
+        }
+        if (sameStimuli && m_saved.stimuli != batch.stimuli) {
+            throw std::runtime_error("RTLflow: checkpoint and batch differ in stimuli");
+        }
+    }
+
+    // Copy stimulus from of src into stimulus to of dst
+    static void copyLane(const RfBatch& dst, size_t to, const RfBatch& src, size_t from,
+                         const RfSegment* segsp, size_t segCount) {
+        for (size_t s = 0; s < segCount; ++s) {
+            const RfSegment& seg = segsp[s];
+            const size_t elemBytes = RF_POOL_BYTES[seg.pool];
+            char* dstp = static_cast<char*>(dst.pools[seg.pool]);
+            const char* srcp = static_cast<const char*>(src.pools[seg.pool]);
+            for (size_t i = 0; i < seg.count; ++i) {
+                const size_t row = seg.memLoc + i * seg.stride;
+                std::memcpy(dstp + (row * dst.stimuli + to * seg.stride) * elemBytes,
+                            srcp + (row * src.stimuli + from * seg.stride) * elemBytes,
+                            seg.stride * elemBytes);
+            }
+        }
+        QData* dstPlanesp = static_cast<QData*>(dst.pools[RF_POOL_B]);
+        const QData* srcPlanesp = static_cast<const QData*>(src.pools[RF_POOL_B]);
+        for (size_t r = 0; r < dst.rows[RF_POOL_B]; ++r) {
+            RF_BIT_SET(dstPlanesp + r * ((dst.stimuli + 63) / 64), to,
+                       RF_BIT_GET(srcPlanesp + r * ((src.stimuli + 63) / 64), from));
+        }
+        dst.change[to] = src.change[from];
+        dst.done[to] = src.done[from];
+    }
+
+    // Restore every stimulus of batch
+    void restore(const RfBatch& batch) const {
+        check(batch, true);
+        for (uint32_t p = 0; p < 5; ++p) {
+            const size_t bytes = batch.poolBytes(p);
+            if (bytes) std::memcpy(batch.pools[p], m_saved.pools[p], bytes);
+        }
+        std::memcpy(batch.change, m_saved.change, batch.stimuli * sizeof(IData));
+        std::memcpy(batch.done, m_saved.done, batch.stimuli * sizeof(bool));
+    }
+
+    // Restore the given stimuli of batch, the others keep their state
+    void restore(const RfBatch& batch, const std::vector<size_t>& lanes, const RfSegment* segsp,
+                 size_t segCount) const {
+        check(batch, true);
+        for (size_t lane : lanes) {
+            if (lane >= batch.stimuli) throw std::runtime_error("RTLflow: lane out of range");
+            copyLane(batch, lane, m_saved, lane, segsp, segCount);
+        }
+    }
+
+    // Set stimuli [begin, end) of batch to saved stimulus from
+    void broadcast(const RfBatch& batch, size_t from, size_t begin, size_t end,
+                   const RfSegment* segsp, size_t segCount) const {
+        check(batch, false);
+        if (from >= m_saved.stimuli || begin > end || end > batch.stimuli) {
+            throw std::runtime_error("RTLflow: lane out of range");
+        }
+        rfBroadcastLane(batch, begin, end, m_saved, from, segsp, segCount);
+    }
+};
+
+}  // namespace RF
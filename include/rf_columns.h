@@ -0,0 +1,281 @@
+#pragma once
+
+// RTLflow: memory-mapped columnar stimulus/response files
+//
+// A file holds the values of a set of ports for N stimuli over M cycles.
+// The header and the port table are followed by one block per port, the
+// M columns of the port in cycle order. A column holds the port for every
+// stimulus in stimulus order, words elements of bytes bytes per stimulus,
+// which is the layout of the port in the RTLflow signal pools, so a column
+// is copied into or out of a batch with a single memcpy.
+//
+//   RfColumnHeader
+//   RfColumnPort[ports]
+//   port 0: column of cycle 0, column of cycle 1, ... (64-byte aligned)
+//   port 1: ...
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rf_heavy.h"
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+const char RF_COLUMNS_MAGIC[8] = {'R', 'F', 'C', 'O', 'L', 'S', '0', '1'};
+
+enum RfColumnDir : uint32_t { RF_COLUMN_IN = 0, RF_COLUMN_OUT = 1, RF_COLUMN_INOUT = 2 };
+
+struct RfColumnHeader final {
+    char magic[8];  ///< RF_COLUMNS_MAGIC
+    uint64_t stimuli;  ///< Stimuli per column
+    uint64_t cycles;  ///< Columns per port
+    uint64_t ports;  ///< Entries of the port table
+    uint64_t reserved[4];
+};
+
+struct RfColumnPort final {
+    char name[96];  ///< Port name, NUL terminated
+    uint32_t width;  ///< Width in bits
+    uint32_t words;  ///< Elements per stimulus, above 1 for wide ports
+    uint32_t bytes;  ///< Bytes per element
+    uint32_t dir;  ///< RfColumnDir
+    uint64_t offset;  ///< File offset of the column of cycle 0
+    uint64_t reserved;
+    uint64_t columnBytes(uint64_t stimuli) const { return stimuli * words * bytes; }
+};
+
+static_assert(sizeof(RfColumnHeader) == 64, "RfColumnHeader layout");
+static_assert(sizeof(RfColumnPort) == 128, "RfColumnPort layout");
+
+class RfColumnReader final {
+    const char* m_datap{nullptr};
+    size_t m_size{0};
+    const RfColumnHeader* m_headerp{nullptr};
+    const RfColumnPort* m_portsp{nullptr};
+
+    template <typename T>
+    static size_t diffColumn(const T* __restrict ap, const T* __restrict bp, size_t stimuli,
+                             size_t words, uint8_t* __restrict mismatchedp) {
+        size_t count = 0;
+        for (size_t i = 0; i < stimuli; ++i) {
+            uint8_t diff = 0;
+            for (size_t w = 0; w < words; ++w) diff |= ap[i * words + w] != bp[i * words + w];
+            count += diff & !mismatchedp[i];
+            mismatchedp[i] |= diff;
+        }
+        return count;
+    }
+
+public:
+    explicit RfColumnReader(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("RTLflow: cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(RfColumnHeader)) {
+            ::close(fd);
+            throw std::runtime_error("RTLflow: truncated column file " + path);
+        }
+        m_size = st.st_size;
+        void* mapp = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapp == MAP_FAILED) throw std::runtime_error("RTLflow: cannot map " + path);
+        m_datap = static_cast<const char*>(mapp);
+        m_headerp = reinterpret_cast<const RfColumnHeader*>(m_datap);
+        m_portsp = reinterpret_cast<const RfColumnPort*>(m_datap + sizeof(RfColumnHeader));
+        if (std::memcmp(m_headerp->magic, RF_COLUMNS_MAGIC, sizeof(RF_COLUMNS_MAGIC)) != 0) {
+            ::munmap(mapp, m_size);
+            throw std::runtime_error("RTLflow: not a column file " + path);
+        }
+        // Every port table entry and column block must lie within the file;
+        // compared by division, as the products of a corrupt header overflow
+        const uint64_t tableBytes = m_size - sizeof(RfColumnHeader);
+        if (ports() > tableBytes / sizeof(RfColumnPort)) {
+            ::munmap(mapp, m_size);
+            throw std::runtime_error("RTLflow: port table of " + std::to_string(ports())
+                                     + " ports beyond the end of column file " + path);
+        }
+        for (size_t p = 0; p < ports(); ++p) {
+            const RfColumnPort& port = m_portsp[p];
+            bool fits = port.offset <= m_size && port.words && port.bytes;
+            if (fits && stimuli() && cycles()) {
+                const uint64_t room = m_size - port.offset;
+                fits = stimuli() <= room / port.words / port.bytes
+                       && cycles() <= room / port.columnBytes(stimuli());
+            }
+            if (!fits) {
+                const std::string name{port.name, ::strnlen(port.name, sizeof(port.name))};
+                ::munmap(mapp, m_size);
+                throw std::runtime_error("RTLflow: columns of port " + name
+                                         + " beyond the end of column file " + path);
+            }
+        }
+    }
+    ~RfColumnReader() { ::munmap(const_cast<char*>(m_datap), m_size); }
+    RfColumnReader(const RfColumnReader&) = delete;
+    RfColumnReader& operator=(const RfColumnReader&) = delete;
+
+    uint64_t stimuli() const { return m_headerp->stimuli; }
+    uint64_t cycles() const { return m_headerp->cycles; }
+    uint64_t ports() const { return m_headerp->ports; }
+    const RfColumnPort& port(size_t p) const { return m_portsp[p]; }
+    const RfColumnPort* find(const char* name) const {
+        for (size_t p = 0; p < ports(); ++p) {
+            if (std::strncmp(m_portsp[p].name, name, sizeof(m_portsp[p].name)) == 0) {
+                return &m_portsp[p];
+            }
+        }
+        return nullptr;
+    }
+    const void* columns(const RfColumnPort& port) const { return m_datap + port.offset; }
+
+    // Stream of the named port into signal, the port's column in a signal pool
+    RfStream stream(const char* name, uint32_t width, uint32_t words, uint32_t bytes,
+                    void* signal) const {
+        const RfColumnPort* portp = find(name);
+        if (!portp) throw std::runtime_error(std::string("RTLflow: no column for port ") + name);
+        if (portp->width != width || portp->words != words || portp->bytes != bytes) {
+            throw std::runtime_error(std::string("RTLflow: column shape mismatch for port ")
+                                     + name);
+        }
+        return {signal, const_cast<void*>(columns(*portp)), portp->columnBytes(stimuli()),
+                cycles()};
+    }
+
+    // Mark in mismatched the stimuli whose columns differ from golden on any
+    // port of golden; returns the number of newly marked stimuli
+    size_t diff(const RfColumnReader& golden, std::vector<uint8_t>& mismatched) const {
+        if (golden.stimuli() != stimuli() || golden.cycles() != cycles()) {
+            throw std::runtime_error("RTLflow: column files differ in stimuli or cycles");
+        }
+        mismatched.resize(stimuli(), 0);
+        size_t count = 0;
+        for (size_t p = 0; p < golden.ports(); ++p) {
+            const RfColumnPort& gport = golden.port(p);
+            const RfColumnPort* portp = find(gport.name);
+            if (!portp || portp->words != gport.words || portp->bytes != gport.bytes) {
+                throw std::runtime_error(std::string("RTLflow: no matching column for port ")
+                                         + gport.name);
+            }
+            const uint64_t bytes = gport.columnBytes(stimuli());
+            for (size_t c = 0; c < cycles(); ++c) {
+                const char* ap = static_cast<const char*>(columns(*portp)) + c * bytes;
+                const char* bp = static_cast<const char*>(golden.columns(gport)) + c * bytes;
+                if (std::memcmp(ap, bp, bytes) == 0) continue;
+                switch (gport.bytes) {
+                case 1:
+                    count += diffColumn(reinterpret_cast<const CData*>(ap),
+                                        reinterpret_cast<const CData*>(bp), stimuli(),
+                                        gport.words, mismatched.data());
+                    break;
+                case 2:
+                    count += diffColumn(reinterpret_cast<const SData*>(ap),
+                                        reinterpret_cast<const SData*>(bp), stimuli(),
+                                        gport.words, mismatched.data());
+                    break;
+                case 4:
+                    count += diffColumn(reinterpret_cast<const IData*>(ap),
+                                        reinterpret_cast<const IData*>(bp), stimuli(),
+                                        gport.words, mismatched.data());
+                    break;
+                default:
+                    count += diffColumn(reinterpret_cast<const QData*>(ap),
+                                        reinterpret_cast<const QData*>(bp), stimuli(),
+                                        gport.words, mismatched.data());
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+};
+
+class RfColumnWriter final {
+    std::string m_path;
+    RfColumnHeader m_header;
+    std::vector<RfColumnPort> m_ports;
+    std::vector<void*> m_signals;  // Pool column of each port, if any
+    char* m_datap{nullptr};
+    size_t m_size{0};
+
+public:
+    RfColumnWriter(const std::string& path, uint64_t stimuli, uint64_t cycles)
+        : m_path{path} {
+        std::memset(&m_header, 0, sizeof(m_header));
+        std::memcpy(m_header.magic, RF_COLUMNS_MAGIC, sizeof(RF_COLUMNS_MAGIC));
+        m_header.stimuli = stimuli;
+        m_header.cycles = cycles;
+    }
+    ~RfColumnWriter() {
+        if (m_datap) {
+            ::msync(m_datap, m_size, MS_SYNC);
+            ::munmap(m_datap, m_size);
+        }
+    }
+    RfColumnWriter(const RfColumnWriter&) = delete;
+    RfColumnWriter& operator=(const RfColumnWriter&) = delete;
+
+    uint64_t stimuli() const { return m_header.stimuli; }
+    uint64_t cycles() const { return m_header.cycles; }
+
+    // Declare a port, before open(); signal is its column in a signal pool
+    // when the port is to be streamed out of a batch
+    void port(const char* name, uint32_t width, uint32_t words, uint32_t bytes, uint32_t dir,
+              void* signal = nullptr) {
+        if (m_datap) throw std::runtime_error("RTLflow: port added to an open column file");
+        RfColumnPort port;
+        std::memset(&port, 0, sizeof(port));
+        std::strncpy(port.name, name, sizeof(port.name) - 1);
+        port.width = width;
+        port.words = words;
+        port.bytes = bytes;
+        port.dir = dir;
+        m_ports.push_back(port);
+        m_signals.push_back(signal);
+    }
+
+    // Lay out and map the file; returns the streams of the ports declared
+    // with a signal
+    std::vector<RfStream> open() {
+        m_header.ports = m_ports.size();
+        uint64_t offset = sizeof(RfColumnHeader) + m_ports.size() * sizeof(RfColumnPort);
+        for (RfColumnPort& port : m_ports) {
+            offset = (offset + 63) / 64 * 64;
+            port.offset = offset;
+            offset += port.columnBytes(m_header.stimuli) * m_header.cycles;
+        }
+        m_size = offset;
+        const int fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+        if (fd < 0) throw std::runtime_error("RTLflow: cannot create " + m_path);
+        if (::ftruncate(fd, m_size) != 0) {
+            ::close(fd);
+            throw std::runtime_error("RTLflow: cannot size " + m_path);
+        }
+        void* mapp = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapp == MAP_FAILED) throw std::runtime_error("RTLflow: cannot map " + m_path);
+        m_datap = static_cast<char*>(mapp);
+        std::memcpy(m_datap, &m_header, sizeof(m_header));
+        std::memcpy(m_datap + sizeof(m_header), m_ports.data(),
+                    m_ports.size() * sizeof(RfColumnPort));
+        std::vector<RfStream> streams;
+        for (size_t p = 0; p < m_ports.size(); ++p) {
+            if (!m_signals[p]) continue;
+            streams.push_back({m_signals[p], columns(p), m_ports[p].columnBytes(m_header.stimuli),
+                               m_header.cycles});
+        }
+        return streams;
+    }
+
+    void* columns(size_t p) const { return m_datap + m_ports[p].offset; }
+};
+
+}  // namespace RF
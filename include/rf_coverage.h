@@ -0,0 +1,45 @@
+#pragma once
+
+// RTLflow: coverage counters of a batch
+//
+// With --coverage every stimulus counts its own cover points. The counters
+// are a pool of IData, the column of bin b holds the count of every
+// stimulus, stimulus i at element b * stimuli + i, so a cover increment
+// never races with another stimulus and the batch total of a bin is the sum
+// of one contiguous column. With --threads the mtasks of one stimulus may
+// run concurrently, so the increments are atomic. The totals, or the counts of a single stimulus,
+// are added into the model's __Vcoverage bins, the counters registered with
+// VerilatedCovContext, which then writes coverage.dat as usual.
+
+#include <cstdint>
+
+#include "verilatedos.h"
+
+#include "rf_heavy.h"
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+// Add each column of pool to the matching bin of counts, saturating as the
+// counts are 32 bits
+inline void rfCoverSum(const IData* __restrict pool, size_t stimuli, size_t bins,
+                       uint32_t* __restrict counts) {
+    for (size_t b = 0; b < bins; ++b) {
+        const IData* __restrict columnp = pool + b * stimuli;
+        vluint64_t sum = counts[b];
+#pragma omp simd reduction(+ : sum)
+        for (size_t i = 0; i < stimuli; ++i) sum += columnp[i];
+        counts[b] = sum > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(sum);
+    }
+}
+
+// Add the counts of stimulus lane to counts
+inline void rfCoverLane(const IData* __restrict pool, size_t stimuli, size_t bins, size_t lane,
+                        uint32_t* __restrict counts) {
+    for (size_t b = 0; b < bins; ++b) {
+        const vluint64_t sum = static_cast<vluint64_t>(counts[b]) + pool[b * stimuli + lane];
+        counts[b] = sum > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(sum);
+    }
+}
+
+}  // namespace RF
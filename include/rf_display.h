@@ -0,0 +1,74 @@
+#pragma once
+
+// RTLflow: --rtlflow-display per-stimulus $display/$write buffers
+//
+// Each stimulus appends the $display/$write statements it executes to its
+// own buffer of RF_DISPLAY_WORDS words; a stimulus is a single thread, so
+// appending takes no lock or atomic. A record is a header word, the
+// format id in the upper and the number of argument words in the lower 32
+// bits, the simulation time the host set with RTLflow::display_time(),
+// then the raw arguments, one word per 64-bit value or per 32-bit word of
+// a wide value. Formatting is left to the host: the generated
+// RTLflow::display_drain() formats the records of every stimulus, in
+// order, with the Verilated formatter, giving $time and %t the recorded
+// time, and empties the buffers. A record that does not fit is dropped
+// and counted. Each model keeps its buffers and time past the signals of
+// its pools, where the generated rfDisplay() finds them.
+
+#include <cstdint>
+#include <cstring>
+
+#include "verilatedos.h"
+
+#include "rf_heavy.h"
+
+#ifndef RF_DISPLAY_WORDS  ///< Define this to override the words buffered per stimulus
+#define RF_DISPLAY_WORDS 1024
+#endif
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+struct RfDisplayRing final {
+    QData* words;  ///< Stimulus i at words[i * capacity]
+    IData* heads;  ///< Words used, per stimulus
+    IData* dropped;  ///< Records dropped, per stimulus
+    size_t capacity;  ///< Words per stimulus
+    QData* time;  ///< Simulation time of the records appended
+};
+
+// Start a record of format fmt with words argument words for stimulus
+// lane; returns where to store the arguments, nullptr if full
+__host__ __device__ inline QData* rfDisplayRecord(const RfDisplayRing& ring, size_t lane,
+                                                  uint32_t fmt, uint32_t words) {
+    const size_t used = ring.heads[lane];
+    if (used + 2 + words > ring.capacity) {
+        ++ring.dropped[lane];
+        return nullptr;
+    }
+    QData* recp = ring.words + lane * ring.capacity + used;
+    recp[0] = (static_cast<QData>(fmt) << 32) | words;
+    recp[1] = *ring.time;
+    ring.heads[lane] = used + 2 + words;
+    return recp + 2;
+}
+
+// Store the words of a wide argument, a pool pointer or a VlWide
+template <typename T>
+__host__ __device__ inline void rfDisplayWide(QData* dstp, const T& src, int words) {
+    for (int w = 0; w < words; ++w) dstp[w] = src[w];
+}
+
+// Store a real argument as its bits, and get it back
+__host__ __device__ inline QData rfDisplayBits(double d) {
+    QData q;
+    memcpy(&q, &d, sizeof(q));
+    return q;
+}
+inline double rfDisplayDouble(QData q) {
+    double d;
+    std::memcpy(&d, &q, sizeof(d));
+    return d;
+}
+
+}  // namespace RF
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "verilatedos.h"
+
+#include <cstddef>
+
 // begin of namespace RF =========================================================================
 namespace RF {
 
@@ -29,6 +33,16 @@ typedef DataLoc<SData> SDataLoc;
 typedef DataLoc<QData> QDataLoc;
 typedef DataLoc<IData> IDataLoc;
 
+// RTLflow: a column holds the value of one port for every stimulus, in
+// stimulus order (size words per stimulus for wide ports), which is the
+// layout of the port in its signal pool
+struct RfStream final {
+    void* signal;  ///< Column of the port in the signal pool
+    void* columns;  ///< Column of cycle c at columns + c * bytes
+    size_t bytes;  ///< Bytes of one column
+    size_t cycles = ~static_cast<size_t>(0);  ///< Columns held, unbounded if sized by the caller
+};
+
 //#define RF_SIG8(name, msb, lsb) CDataLoc name  ///< Declare signal, 1-8 bits
 //#define RF_SIG16(name, msb, lsb) SDataLoc name  ///< Declare signal, 9-16 bits
 //#define RF_SIG64(name, msb, lsb) QDataLoc name  ///< Declare signal, 33-64 bits
@@ -54,21 +68,21 @@ template <class T_Value, std::size_t T_Depth> struct RfUnpacked final {
 
     T_Value m_array[T_Depth];
 
-    __device__ T_Value& operator[](size_t index) { return m_array[index]; }
-    __device__ const T_Value& operator[](size_t index) const { return m_array[index]; }
+    __host__ __device__ T_Value& operator[](size_t index) { return m_array[index]; }
+    __host__ __device__ const T_Value& operator[](size_t index) const { return m_array[index]; }
 };
 
 template <std::size_t T_Words> struct RfWide final {
     IData m_storage[T_Words];
 
-    __device__ const IData& operator[](size_t index) const { return m_storage[index]; };
-    __device__ IData& operator[](size_t index) { return m_storage[index]; };
-    __device__ operator WDataOutP() { return &m_storage[0]; }
-    __device__ operator WDataInP() const { return &m_storage[0]; }
+    __host__ __device__ const IData& operator[](size_t index) const { return m_storage[index]; };
+    __host__ __device__ IData& operator[](size_t index) { return m_storage[index]; };
+    __host__ __device__ operator WDataOutP() { return &m_storage[0]; }
+    __host__ __device__ operator WDataInP() const { return &m_storage[0]; }
 
     // METHODS
-    __device__ const IData& at(size_t index) const { return m_storage[index]; }
-    __device__ IData& at(size_t index) { return m_storage[index]; }
+    __host__ __device__ const IData& at(size_t index) const { return m_storage[index]; }
+    __host__ __device__ IData& at(size_t index) { return m_storage[index]; }
     WData* data() { return &m_storage[0]; }
     const WData* data() const { return &m_storage[0]; }
     // bool operator<(const VlWide<T_Words>& rhs) const {
@@ -76,6 +90,24 @@ template <std::size_t T_Words> struct RfWide final {
     //}
 };
 
+// RTLflow: --rtlflow-bitslice
+// Bit k of word w of a bit plane holds the value of stimulus 64 * w + k
+#ifdef GPU_THREADS
+   const size_t BWORDS = (THREADS + 63) / 64;  ///< Words of one bit plane
+#endif
+
+__host__ __device__ static inline CData RF_BIT_GET(const QData* planep, size_t i) {
+    return static_cast<CData>((planep[i >> 6] >> (i & 63)) & 1ULL);
+}
+__host__ __device__ static inline void RF_BIT_SET(QData* planep, size_t i, QData value) {
+    const QData bit = 1ULL << (i & 63);
+    planep[i >> 6] = (planep[i >> 6] & ~bit) | ((value & 1ULL) ? bit : 0ULL);
+}
+// Update the bits of a plane word selected by mask (the active stimuli)
+__host__ __device__ static inline void RF_WORD_SET(QData& word, QData mask, QData value) {
+    word = (word & ~mask) | (value & mask);
+}
+
 //# define RF_LIKELY(x) __builtin_expect(!!(x), 1)
 //# define RF_UNLIKELY(x) __builtin_expect(!!(x), 0)
 
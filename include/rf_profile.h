@@ -0,0 +1,190 @@
+#pragma once
+
+// RTLflow: --rtlflow-prof host-side profiling of the batch simulator
+//
+// Records are VL_RDTSC start/end stamps of mtask invocations (one per chunk
+// on the CPU backend), of settle-loop iterations and of whole evaluations.
+// Each executor worker appends to its own vector, so recording takes no lock.
+// A vector holds at most RF_PROF_MAX_RECORDS records, later ones are counted
+// as dropped, so a long run does not grow without bound; RTLflow::
+// profile_clear() empties them, e.g. after a warm-up or between windows.
+
+#include "verilatedos.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifndef RF_PROF_MAX_RECORDS  ///< Define this to override the records kept per worker
+#define RF_PROF_MAX_RECORDS (1 << 20)
+#endif
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+enum RfProfKind : uint32_t { RF_PROF_MTASK = 0, RF_PROF_ITER = 1, RF_PROF_EVAL = 2 };
+
+struct RfProfRec final {
+    vluint64_t start;  ///< VL_RDTSC at start
+    vluint64_t end;  ///< VL_RDTSC at end
+    uint32_t kind;  ///< RfProfKind
+    uint32_t id;  ///< Mtask id, iteration or evaluation number
+    uint32_t chunk;  ///< Chunk of stimuli, mtasks only
+};
+
+class RfProfiler final {
+    std::vector<std::vector<RfProfRec>> m_recs;  // Per worker, last for other threads
+    std::vector<size_t> m_dropped;  // Per worker, records past RF_PROF_MAX_RECORDS
+    vluint64_t m_tick0;
+    std::chrono::steady_clock::time_point m_time0;
+
+public:
+    explicit RfProfiler(size_t workers)
+        : m_recs(workers + 1)
+        , m_dropped(workers + 1) {
+        m_tick0 = ticks();
+        m_time0 = std::chrono::steady_clock::now();
+    }
+    static vluint64_t ticks() {
+        vluint64_t val;
+        VL_RDTSC(val);
+        return val;
+    }
+    void record(int worker, uint32_t kind, uint32_t id, uint32_t chunk, vluint64_t start,
+                vluint64_t end) {
+        const size_t w = worker < 0 ? m_recs.size() - 1 : static_cast<size_t>(worker);
+        if (m_recs[w].size() >= RF_PROF_MAX_RECORDS) {
+            ++m_dropped[w];
+            return;
+        }
+        m_recs[w].push_back({start, end, kind, id, chunk});
+    }
+    void clear() {
+        for (auto& recs : m_recs) recs.clear();
+        std::fill(m_dropped.begin(), m_dropped.end(), 0);
+    }
+    size_t dropped() const {
+        size_t count = 0;
+        for (size_t n : m_dropped) count += n;
+        return count;
+    }
+    // Counter rate, calibrated against steady_clock since construction
+    double ticksPerUs() const {
+        const double us = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - m_time0)
+                              .count();
+        const double ticks = static_cast<double>(RfProfiler::ticks() - m_tick0);
+        return (us > 0 && ticks > 0) ? ticks / us : 1.0;
+    }
+
+    // Chrome trace (chrome://tracing, Perfetto), one row per worker
+    bool writeTrace(const std::string& path) const {
+        FILE* fp = std::fopen(path.c_str(), "w");
+        if (!fp) return false;
+        static const char* const names[] = {"mtask", "iteration", "eval"};
+        const double rate = ticksPerUs();
+        std::fprintf(fp, "{\"traceEvents\":[\n");
+        bool first = true;
+        for (size_t w = 0; w < m_recs.size(); ++w) {
+            for (const RfProfRec& rec : m_recs[w]) {
+                std::fprintf(fp,
+                             "%s{\"name\":\"%s %u\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,"
+                             "\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"chunk\":%u}}",
+                             first ? "" : ",\n", names[rec.kind], rec.id, names[rec.kind], w,
+                             (rec.start - m_tick0) / rate, (rec.end - rec.start) / rate,
+                             rec.chunk);
+                first = false;
+            }
+        }
+        std::fprintf(fp, "\n],\"displayTimeUnit\":\"ns\"}\n");
+        std::fclose(fp);
+        return true;
+    }
+
+    // Per-mtask table of the V3InstrCount estimate against the measured
+    // time, each also as a share of its total, sorted by measured time
+    bool writeSummary(const std::string& path, const std::map<uint32_t, uint32_t>& costs) const {
+        FILE* fp = std::fopen(path.c_str(), "w");
+        if (!fp) return false;
+        struct Sum {
+            vluint64_t ticks = 0;
+            size_t calls = 0;
+        };
+        std::map<uint32_t, Sum> mtasks;
+        Sum kinds[3];
+        for (const auto& recs : m_recs) {
+            for (const RfProfRec& rec : recs) {
+                kinds[rec.kind].ticks += rec.end - rec.start;
+                ++kinds[rec.kind].calls;
+                if (rec.kind != RF_PROF_MTASK) continue;
+                mtasks[rec.id].ticks += rec.end - rec.start;
+                ++mtasks[rec.id].calls;
+            }
+        }
+        const double rate = ticksPerUs();
+        std::fprintf(fp, "evaluations   %zu, %.3f us each\n", kinds[RF_PROF_EVAL].calls,
+                     kinds[RF_PROF_EVAL].calls
+                         ? kinds[RF_PROF_EVAL].ticks / rate / kinds[RF_PROF_EVAL].calls
+                         : 0.0);
+        std::fprintf(fp, "iterations    %zu, %.3f us each\n", kinds[RF_PROF_ITER].calls,
+                     kinds[RF_PROF_ITER].calls
+                         ? kinds[RF_PROF_ITER].ticks / rate / kinds[RF_PROF_ITER].calls
+                         : 0.0);
+        std::fprintf(fp, "dropped       %zu, past RF_PROF_MAX_RECORDS\n\n", dropped());
+        double totalCost = 0;
+        for (const auto& it : costs) totalCost += it.second;
+        const double totalTicks = static_cast<double>(kinds[RF_PROF_MTASK].ticks);
+        std::vector<uint32_t> ids;
+        for (const auto& it : costs) ids.push_back(it.first);
+        std::stable_sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+            const auto ait = mtasks.find(a);
+            const auto bit = mtasks.find(b);
+            return (ait == mtasks.end() ? 0 : ait->second.ticks)
+                   > (bit == mtasks.end() ? 0 : bit->second.ticks);
+        });
+        std::fprintf(fp, "%8s %10s %7s %8s %12s %7s %7s\n", "mtask", "est.cost", "est.%",
+                     "calls", "measured.us", "meas.%", "ratio");
+        for (uint32_t id : ids) {
+            const auto it = mtasks.find(id);
+            const Sum sum = it == mtasks.end() ? Sum{} : it->second;
+            const double estPct = totalCost > 0 ? 100.0 * costs.at(id) / totalCost : 0.0;
+            const double measPct = totalTicks > 0 ? 100.0 * sum.ticks / totalTicks : 0.0;
+            std::fprintf(fp, "%8u %10u %7.2f %8zu %12.3f %7.2f %7.2f\n", id, costs.at(id), estPct,
+                         sum.calls, sum.ticks / rate, measPct,
+                         estPct > 0 ? measPct / estPct : 0.0);
+        }
+        std::fclose(fp);
+        return true;
+    }
+
+    // Measured time of each mtask keyed by its hash, the input of
+    // verilator --rtlflow-prof-cost
+    bool writeCosts(const std::string& path, const std::map<uint32_t, uint32_t>& costs,
+                    const std::map<uint32_t, vluint64_t>& hashes) const {
+        FILE* fp = std::fopen(path.c_str(), "w");
+        if (!fp) return false;
+        std::map<uint32_t, std::pair<vluint64_t, size_t>> mtasks;  // Ticks and calls
+        for (const auto& recs : m_recs) {
+            for (const RfProfRec& rec : recs) {
+                if (rec.kind != RF_PROF_MTASK) continue;
+                mtasks[rec.id].first += rec.end - rec.start;
+                ++mtasks[rec.id].second;
+            }
+        }
+        const double rate = ticksPerUs();
+        std::fprintf(fp, "# hash est.cost measured.us calls\n");
+        for (const auto& it : hashes) {
+            const auto mit = mtasks.find(it.first);
+            if (mit == mtasks.end()) continue;
+            std::fprintf(fp, "%016llx %u %.3f %zu\n", static_cast<unsigned long long>(it.second),
+                         costs.at(it.first), mit->second.first / rate, mit->second.second);
+        }
+        std::fclose(fp);
+        return true;
+    }
+};
+
+}  // namespace RF
@@ -0,0 +1,95 @@
+#pragma once
+
+// RTLflow: coverage-directed retirement of stimuli
+//
+// A retirer is checked periodically by the driver loop, through
+// RTLflow::retire(). A stimulus makes progress at a check when it hit a
+// cover point no stimulus had hit before (only the columns of bins not yet
+// covered by the batch are read), or when the user's interesting predicate
+// holds for it. A stimulus without progress over the last window checks is
+// retired: its done flag is set, so the kernels skip it, and the refill
+// callback may load a fresh stimulus into the lane (e.g. with
+// RTLflow::fork() from a reset lane or RTLflow::restore(path, lanes)) and
+// return true to put the lane back to work.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "verilatedos.h"
+
+#include "rf_heavy.h"
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+class RfRetirer final {
+public:
+    using Predicate = std::function<bool(size_t lane)>;
+
+private:
+    size_t m_stimuli;
+    uint64_t m_window;  // Checks without progress before retirement
+    Predicate m_refill;  // Loads a fresh stimulus, true to keep the lane
+    Predicate m_interesting;  // User-defined progress
+    uint64_t m_check = 0;  // Current check
+    std::vector<uint64_t> m_last;  // Check of the last progress, per lane
+    std::vector<uint8_t> m_covered;  // Bins hit by any stimulus
+    size_t m_coveredBins = 0;
+    size_t m_retired = 0;
+    size_t m_refilled = 0;
+
+public:
+    RfRetirer(size_t stimuli, uint64_t window, Predicate refill = nullptr,
+              Predicate interesting = nullptr)
+        : m_stimuli{stimuli}
+        , m_window{window ? window : 1}
+        , m_refill{refill}
+        , m_interesting{interesting}
+        , m_last(stimuli, 0) {}
+
+    size_t stimuli() const { return m_stimuli; }
+    size_t coveredBins() const { return m_coveredBins; }
+    size_t retired() const { return m_retired; }
+    size_t refilled() const { return m_refilled; }
+
+    // Credit the stimuli that hit a bin not covered before, from the
+    // coverage pool, stimulus i of bin b at pool[b * stimuli + i]
+    void credit(const IData* __restrict pool, size_t bins) {
+        if (m_covered.size() < bins) m_covered.resize(bins, 0);
+        for (size_t b = 0; b < bins; ++b) {
+            if (m_covered[b]) continue;
+            const IData* __restrict columnp = pool + b * m_stimuli;
+            for (size_t i = 0; i < m_stimuli; ++i) {
+                if (!columnp[i]) continue;
+                m_last[i] = m_check;
+                m_covered[b] = 1;
+            }
+            m_coveredBins += m_covered[b];
+        }
+    }
+
+    // Retire the running stimuli without progress in the last window
+    // checks and refill them; returns the lanes retired at this check
+    std::vector<size_t> retire(bool* done, IData* change) {
+        std::vector<size_t> lanes;
+        for (size_t i = 0; i < m_stimuli; ++i) {
+            if (done[i]) continue;
+            if (m_interesting && m_interesting(i)) m_last[i] = m_check;
+            if (m_check - m_last[i] < m_window) continue;
+            done[i] = true;
+            ++m_retired;
+            lanes.push_back(i);
+            if (m_refill && m_refill(i)) {
+                done[i] = false;
+                change[i] = 1;
+                m_last[i] = m_check;
+                ++m_refilled;
+            }
+        }
+        ++m_check;
+        return lanes;
+    }
+};
+
+}  // namespace RF
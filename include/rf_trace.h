@@ -0,0 +1,280 @@
+#pragma once
+
+// RTLflow: per-stimulus waveforms of a batch
+//
+// A tracer follows a few lanes (stimulus indices) of the batch and writes
+// one waveform per lane. The signals are described by the generated
+// rfTraceSignals table; each 8/16/32/64-bit signal, or 32-bit word of a
+// wide signal, is a trace entry. At each dump the generated code gathers
+// the entries of the traced lanes from the signal pools into buffer(),
+// entry e of lane i at buffer()[i * entries() + e], and dump() writes the
+// entries that changed since the previous dump. The other stimuli of the
+// batch are never read.
+//
+// Files named *.fst are written with the GTKWave FST API, which needs
+// RF_TRACE_FST defined and include/gtkwave/{fstapi,fastlz,lz4}.c built
+// into the simulator; any other file name is written as VCD.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "verilatedos.h"
+
+#include "rf_heavy.h"
+
+#ifdef RF_TRACE_FST
+#include "gtkwave/fstapi.h"
+#endif
+
+// begin of namespace RF =========================================================================
+namespace RF {
+
+enum RfTracePool : uint32_t {
+    RF_TRACE_CDATA = 0,
+    RF_TRACE_SDATA = 1,
+    RF_TRACE_IDATA = 2,
+    RF_TRACE_QDATA = 3
+};
+
+struct RfTraceSignal final {
+    const char* name;  ///< Hierarchical name, '.' separated, first scope TOP
+    uint32_t msb;  ///< Declared range
+    uint32_t lsb;
+    uint32_t pool;  ///< RfTracePool
+    uint32_t words;  ///< Elements per stimulus, above 1 for wide signals
+    size_t memLoc;  ///< Pool location, stimulus 0 at element memLoc * stimuli
+    uint32_t width() const { return msb >= lsb ? msb - lsb + 1 : lsb - msb + 1; }
+};
+
+// One entry of the gather: element offset + lane * stride of pool
+struct RfTraceEntry final {
+    uint32_t pool;  ///< RfTracePool
+    uint32_t stride;  ///< Elements per stimulus
+    size_t offset;  ///< Element of stimulus 0
+};
+
+class RfLaneTracer final {
+    // One waveform file
+    class Sink final {
+        FILE* m_fp = nullptr;
+#ifdef RF_TRACE_FST
+        void* m_fst = nullptr;
+        std::vector<fstHandle> m_handles;
+#endif
+    public:
+        Sink(const std::string& path, const std::string& timescale) {
+            if (path.size() > 4 && path.compare(path.size() - 4, 4, ".fst") == 0) {
+#ifdef RF_TRACE_FST
+                m_fst = fstWriterCreate(path.c_str(), 1);
+                if (!m_fst) throw std::runtime_error("RTLflow: cannot create " + path);
+                fstWriterSetPackType(m_fst, FST_WR_PT_LZ4);
+                fstWriterSetTimescaleFromString(m_fst, timescale.c_str());
+                return;
+#else
+                throw std::runtime_error("RTLflow: FST tracing needs RF_TRACE_FST, for " + path);
+#endif
+            }
+            m_fp = std::fopen(path.c_str(), "w");
+            if (!m_fp) throw std::runtime_error("RTLflow: cannot create " + path);
+            std::fprintf(m_fp, "$version RTLflow $end\n$timescale %s $end\n", timescale.c_str());
+        }
+        ~Sink() {
+            if (m_fp) std::fclose(m_fp);
+#ifdef RF_TRACE_FST
+            if (m_fst) fstWriterClose(m_fst);
+#endif
+        }
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+        static std::string code(size_t n) {
+            std::string s;
+            do {
+                s += static_cast<char>('!' + n % 94);
+                n /= 94;
+            } while (n);
+            return s;
+        }
+        void scope(const std::string& name) {
+            if (m_fp) std::fprintf(m_fp, "$scope module %s $end\n", name.c_str());
+#ifdef RF_TRACE_FST
+            if (m_fst) fstWriterSetScope(m_fst, FST_ST_VCD_MODULE, name.c_str(), nullptr);
+#endif
+        }
+        void upscope() {
+            if (m_fp) std::fprintf(m_fp, "$upscope $end\n");
+#ifdef RF_TRACE_FST
+            if (m_fst) fstWriterSetUpscope(m_fst);
+#endif
+        }
+        void var(size_t s, const std::string& name, const RfTraceSignal& sig) {
+            if (m_fp) {
+                std::fprintf(m_fp, "$var wire %u %s %s", sig.width(), code(s).c_str(),
+                             name.c_str());
+                if (sig.width() > 1 || sig.lsb) std::fprintf(m_fp, " [%u:%u]", sig.msb, sig.lsb);
+                std::fprintf(m_fp, " $end\n");
+            }
+#ifdef RF_TRACE_FST
+            if (m_fst) {
+                const std::string full = (sig.width() > 1 || sig.lsb)
+                                             ? name + " [" + std::to_string(sig.msb) + ":"
+                                                   + std::to_string(sig.lsb) + "]"
+                                             : name;
+                m_handles.push_back(fstWriterCreateVar(m_fst, FST_VT_VCD_WIRE, FST_VD_IMPLICIT,
+                                                       sig.width(), full.c_str(), 0));
+            }
+#endif
+        }
+        void enddefinitions() {
+            if (m_fp) std::fprintf(m_fp, "$enddefinitions $end\n");
+        }
+        void time(vluint64_t time) {
+            if (m_fp) std::fprintf(m_fp, "#%llu\n", static_cast<unsigned long long>(time));
+#ifdef RF_TRACE_FST
+            if (m_fst) fstWriterEmitTimeChange(m_fst, time);
+#endif
+        }
+        void value(size_t s, const std::string& bits) {
+            if (m_fp) {
+                if (bits.size() == 1) {
+                    std::fprintf(m_fp, "%s%s\n", bits.c_str(), code(s).c_str());
+                } else {
+                    std::fprintf(m_fp, "b%s %s\n", bits.c_str(), code(s).c_str());
+                }
+            }
+#ifdef RF_TRACE_FST
+            if (m_fst) fstWriterEmitValueChange(m_fst, m_handles[s], bits.c_str());
+#endif
+        }
+    };
+
+    const RfTraceSignal* m_sigsp;
+    size_t m_sigCount;
+    std::vector<size_t> m_lanes;
+    std::vector<std::unique_ptr<Sink>> m_sinks;  // Per lane
+    std::vector<RfTraceEntry> m_entries;
+    std::vector<size_t> m_firstEntry;  // Per signal, and one past the end
+    std::vector<QData> m_buffer;  // Gathered values, per lane
+    std::vector<QData> m_prev;  // Values at the previous dump
+    bool m_dumped = false;
+
+    std::string bits(const RfTraceSignal& sig, const QData* valuesp) const {
+        std::string s(sig.width(), '0');
+        for (uint32_t b = 0; b < sig.width(); ++b) {
+            const uint32_t wordBits = sig.words > 1 ? 32 : 64;
+            if ((valuesp[b / wordBits] >> (b % wordBits)) & 1) s[sig.width() - 1 - b] = '1';
+        }
+        return s;
+    }
+
+public:
+    // Opens prefix_<lane>suffix for each lane of a batch of stimuli
+    RfLaneTracer(const RfTraceSignal* sigsp, size_t sigCount, size_t stimuli,
+                 const std::vector<size_t>& lanes, const std::string& prefix,
+                 const std::string& suffix, const std::string& timescale)
+        : m_sigsp{sigsp}
+        , m_sigCount{sigCount}
+        , m_lanes{lanes} {
+        for (size_t s = 0; s < m_sigCount; ++s) {
+            m_firstEntry.push_back(m_entries.size());
+            for (uint32_t w = 0; w < m_sigsp[s].words; ++w) {
+                m_entries.push_back(
+                    {m_sigsp[s].pool, m_sigsp[s].words, m_sigsp[s].memLoc * stimuli + w});
+            }
+        }
+        m_firstEntry.push_back(m_entries.size());
+        for (size_t lane : m_lanes) {
+            if (lane >= stimuli) throw std::runtime_error("RTLflow: traced lane out of range");
+        }
+        m_buffer.resize(m_lanes.size() * m_entries.size());
+        m_prev.resize(m_buffer.size());
+
+        // Signals in name order, so each scope is declared once
+        std::vector<size_t> order(m_sigCount);
+        for (size_t s = 0; s < m_sigCount; ++s) order[s] = s;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return std::string{m_sigsp[a].name} < std::string{m_sigsp[b].name};
+        });
+        for (size_t lane : m_lanes) {
+            m_sinks.emplace_back(
+                new Sink{prefix + "_" + std::to_string(lane) + suffix, timescale});
+            Sink& sink = *m_sinks.back();
+            std::vector<std::string> scopes;
+            for (size_t s : order) {
+                std::vector<std::string> path;
+                const std::string name{m_sigsp[s].name};
+                for (size_t pos = 0, dot; pos <= name.size(); pos = dot + 1) {
+                    dot = name.find('.', pos);
+                    if (dot == std::string::npos) dot = name.size();
+                    path.push_back(name.substr(pos, dot - pos));
+                }
+                const std::string leaf = path.back();
+                path.pop_back();
+                size_t common = 0;
+                while (common < scopes.size() && common < path.size()
+                       && scopes[common] == path[common]) {
+                    ++common;
+                }
+                for (; scopes.size() > common; scopes.pop_back()) sink.upscope();
+                for (; scopes.size() < path.size(); scopes.push_back(path[scopes.size()])) {
+                    sink.scope(path[scopes.size()]);
+                }
+                sink.var(s, leaf, m_sigsp[s]);
+            }
+            for (; !scopes.empty(); scopes.pop_back()) sink.upscope();
+            sink.enddefinitions();
+        }
+    }
+    RfLaneTracer(const RfLaneTracer&) = delete;
+    RfLaneTracer& operator=(const RfLaneTracer&) = delete;
+
+    const std::vector<size_t>& lanes() const { return m_lanes; }
+    const std::vector<RfTraceEntry>& entries() const { return m_entries; }
+    QData* buffer() { return m_buffer.data(); }
+
+    // Gather from host-accessible pools
+    void gather(const CData* csignals, const SData* ssignals, const IData* isignals,
+                const QData* qsignals) {
+        QData* outp = m_buffer.data();
+        for (size_t lane : m_lanes) {
+            for (const RfTraceEntry& e : m_entries) {
+                const size_t at = e.offset + lane * e.stride;
+                switch (e.pool) {
+                case RF_TRACE_CDATA: *outp++ = csignals[at]; break;
+                case RF_TRACE_SDATA: *outp++ = ssignals[at]; break;
+                case RF_TRACE_IDATA: *outp++ = isignals[at]; break;
+                default: *outp++ = qsignals[at]; break;
+                }
+            }
+        }
+    }
+
+    // Write the signals of each lane that changed since the previous dump,
+    // all of them on the first dump
+    void dump(vluint64_t time) {
+        const size_t entryCount = m_entries.size();
+        for (size_t l = 0; l < m_lanes.size(); ++l) {
+            const QData* curp = m_buffer.data() + l * entryCount;
+            QData* prevp = m_prev.data() + l * entryCount;
+            bool timed = false;
+            for (size_t s = 0; s < m_sigCount; ++s) {
+                const size_t first = m_firstEntry[s];
+                const size_t last = m_firstEntry[s + 1];
+                if (m_dumped && std::equal(curp + first, curp + last, prevp + first)) continue;
+                if (!timed) {
+                    m_sinks[l]->time(time);
+                    timed = true;
+                }
+                m_sinks[l]->value(s, bits(m_sigsp[s], curp + first));
+                std::copy(curp + first, curp + last, prevp + first);
+            }
+        }
+        m_dumped = true;
+    }
+};
+
+}  // namespace RF
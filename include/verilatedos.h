@@ -135,6 +135,13 @@
 # define VL_PREFETCH_RW(p)  ///< Prefetch pointer argument with read/write intent
 #endif
 
+// CUDA function qualifiers, empty when not compiled by nvcc (--rtlflow-backend cpu)
+#ifndef __CUDACC__
+# define __host__  ///< Function callable from the host
+# define __device__  ///< Function callable from a kernel
+# define __global__  ///< Kernel entry point
+#endif
+
 #if defined(VL_THREADED) && !defined(VL_CPPCHECK)
 # if defined(_MSC_VER) && _MSC_VER >= 1900
 #  define VL_THREAD_LOCAL thread_local
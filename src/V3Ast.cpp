@@ -20,6 +20,7 @@
 #include "V3Ast.h"
 #include "V3File.h"
 #include "V3Global.h"
+#include "V3AstArena.h"
 #include "V3Broken.h"
 #include "V3String.h"
 
@@ -30,23 +31,33 @@
 // Statics
 
 vluint64_t AstNode::s_editCntLast = 0;
-vluint64_t AstNode::s_editCntGbl = 0;  // Hot cache line
+std::atomic<vluint64_t> AstNode::s_editCntGbl{0};  // Hot cache line
 
 // To allow for fast clearing of all user pointers, we keep a "timestamp"
 // along with each userp, and thus by bumping this count we can make it look
 // as if we iterated across the entire tree to set all the userp's to null.
-int AstNode::s_cloneCntGbl = 0;
-uint32_t AstUser1InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t AstUser2InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t AstUser3InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t AstUser4InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t AstUser5InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-
-bool AstUser1InUse::s_userBusy = false;
-bool AstUser2InUse::s_userBusy = false;
-bool AstUser3InUse::s_userBusy = false;
-bool AstUser4InUse::s_userBusy = false;
-bool AstUser5InUse::s_userBusy = false;
+std::atomic<uint32_t> AstUserInUseBase::s_cntNext{0};
+thread_local int AstNode::s_cloneCntGbl = 0;
+thread_local uint32_t AstUser1InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t AstUser2InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t AstUser3InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t AstUser4InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t AstUser5InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+
+thread_local bool AstUser1InUse::s_userBusy = false;
+thread_local bool AstUser2InUse::s_userBusy = false;
+thread_local bool AstUser3InUse::s_userBusy = false;
+thread_local bool AstUser4InUse::s_userBusy = false;
+thread_local bool AstUser5InUse::s_userBusy = false;
+
+void AstNode::userThreadFresh() {
+    AstUser1InUse::s_userCntGbl = AstUserInUseBase::cntNext();
+    AstUser2InUse::s_userCntGbl = AstUserInUseBase::cntNext();
+    AstUser3InUse::s_userCntGbl = AstUserInUseBase::cntNext();
+    AstUser4InUse::s_userCntGbl = AstUserInUseBase::cntNext();
+    AstUser5InUse::s_userCntGbl = AstUserInUseBase::cntNext();
+    cloneClearTree();
+}
 
 int AstNodeDType::s_uniqueNum = 0;
 
@@ -772,21 +783,25 @@ void AstNode::deleteTree() {
 //======================================================================
 // Memory checks
 
-#ifdef VL_LEAK_CHECKS
 void* AstNode::operator new(size_t size) {
     // Optimization note: Aligning to cache line is a loss, due to lost packing
-    AstNode* objp = static_cast<AstNode*>(::operator new(size));
+    UASSERT_STATIC(size <= V3AstArena::MAX_BYTES,
+                   "AstNode is larger than V3AstArena::MAX_BYTES, increase it");
+    AstNode* objp = static_cast<AstNode*>(V3AstArena::alloc(size));
+#ifdef VL_LEAK_CHECKS
     V3Broken::addNewed(objp);
+#endif
     return objp;
 }
 
 void AstNode::operator delete(void* objp, size_t size) {
     if (!objp) return;
+#ifdef VL_LEAK_CHECKS
     AstNode* nodep = static_cast<AstNode*>(objp);
     V3Broken::deleted(nodep);
-    ::operator delete(objp);
-}
 #endif
+    V3AstArena::free(objp, size);
+}
 
 //======================================================================
 // Iterators
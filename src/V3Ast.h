@@ -25,6 +25,7 @@
 #include "V3Number.h"
 #include "V3Global.h"
 
+#include <atomic>
 #include <cmath>
 #include <unordered_set>
 
@@ -1154,8 +1155,23 @@ public:
 //  This will clear the tree, and prevent another visitor from clobbering
 //  user2.  When the member goes out of scope it will be automagically
 //  freed up.
+//
+//  The counts are per thread, so V3ThreadPool jobs each get user#() fields
+//  of their own, provided they do not touch the same nodes. Every clear
+//  takes a new count from s_cntNext, shared by all threads, so a count one
+//  thread set is never mistaken for the current count of another.
 
 class AstUserInUseBase VL_NOT_FINAL {
+protected:
+    static std::atomic<uint32_t> s_cntNext;  // Next count of any user#() and clone
+
+public:
+    static uint32_t cntNext() {
+        const uint32_t cnt = ++s_cntNext;
+        UASSERT_STATIC(cnt, "User*() overflowed!");
+        return cnt;
+    }
+
 protected:
     static void allocate(int id, uint32_t& cntGblRef, bool& userBusyRef) {
         // Perhaps there's still a AstUserInUse in scope for this?
@@ -1173,8 +1189,7 @@ protected:
         UASSERT_STATIC(userBusyRef, "Clear of User" + cvtToStr(id) + "() not under AstUserInUse");
         // If this really fires and is real (after 2^32 edits???)
         // we could just walk the tree and clear manually
-        ++cntGblRef;
-        UASSERT_STATIC(cntGblRef, "User*() overflowed!");
+        cntGblRef = cntNext();
     }
     static void checkcnt(int id, uint32_t&, const bool& userBusyRef) {
         UASSERT_STATIC(userBusyRef,
@@ -1189,8 +1204,8 @@ protected:
 class AstUser1InUse final : AstUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t     s_userCntGbl;   // Count of which usage of userp() this is
-    static bool         s_userBusy;     // Count is in use
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool     s_userBusy;    // Count is in use
 public:
     AstUser1InUse()     { allocate(1, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~AstUser1InUse()    { free    (1, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1200,8 +1215,8 @@ public:
 class AstUser2InUse final : AstUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t     s_userCntGbl;   // Count of which usage of userp() this is
-    static bool         s_userBusy;     // Count is in use
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool     s_userBusy;    // Count is in use
 public:
     AstUser2InUse()     { allocate(2, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~AstUser2InUse()    { free    (2, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1211,8 +1226,8 @@ public:
 class AstUser3InUse final : AstUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t     s_userCntGbl;   // Count of which usage of userp() this is
-    static bool         s_userBusy;     // Count is in use
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool     s_userBusy;    // Count is in use
 public:
     AstUser3InUse()     { allocate(3, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~AstUser3InUse()    { free    (3, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1222,8 +1237,8 @@ public:
 class AstUser4InUse final : AstUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t     s_userCntGbl;   // Count of which usage of userp() this is
-    static bool         s_userBusy;     // Count is in use
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool     s_userBusy;    // Count is in use
 public:
     AstUser4InUse()     { allocate(4, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~AstUser4InUse()    { free    (4, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1233,8 +1248,8 @@ public:
 class AstUser5InUse final : AstUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t     s_userCntGbl;   // Count of which usage of userp() this is
-    static bool         s_userBusy;     // Count is in use
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool     s_userBusy;    // Count is in use
 public:
     AstUser5InUse()     { allocate(5, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~AstUser5InUse()    { free    (5, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1363,12 +1378,12 @@ class AstNode VL_NOT_FINAL {
     AstNode* m_headtailp;  // When at begin/end of list, the opposite end of the list
     FileLine* m_fileline;  // Where it was declared
     vluint64_t m_editCount;  // When it was last edited
-    static vluint64_t s_editCntGbl;  // Global edit counter
+    static std::atomic<vluint64_t> s_editCntGbl;  // Global edit counter
     // Global edit counter, last value for printing * near node #s
     static vluint64_t s_editCntLast;
 
     AstNode* m_clonep;  // Pointer to clone of/ source of this module (for *LAST* cloneTree() ONLY)
-    static int s_cloneCntGbl;  // Count of which userp is set
+    static thread_local int s_cloneCntGbl;  // Count of which userp is set, per thread
 
     // Attributes
     bool m_didWidth : 1;  // Did V3Width computation
@@ -1458,7 +1473,8 @@ protected:
         m_cloneCnt = s_cloneCntGbl;
     }
     static void cloneClearTree() {
-        s_cloneCntGbl++;
+        // A count no other thread uses, see AstUserInUseBase
+        s_cloneCntGbl = static_cast<int>(AstUserInUseBase::cntNext());
         UASSERT_STATIC(s_cloneCntGbl, "Rollover");
     }
 
@@ -1484,10 +1500,8 @@ public:
 
     // CONSTRUCTORS
     virtual ~AstNode() = default;
-#ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
-#endif
 
     // CONSTANT ACCESSORS
     static int instrCountBranch() { return 4; }  ///< Instruction cycles to branch
@@ -1630,6 +1644,9 @@ public:
     int         user5SetOnce() { int v=user5(); if (!v) user5(1); return v; }  // Better for cache than user5Inc()
     static void user5ClearTree() { AstUser5InUse::clear(); }  // Clear userp()'s across the entire tree
     // clang-format on
+    // Give the calling thread counts no node was marked with. A new thread's
+    // counts start at zero, which marks left by any earlier thread may match.
+    static void userThreadFresh();
 
     vluint64_t editCount() const { return m_editCount; }
     void editCountInc() {
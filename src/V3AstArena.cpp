@@ -0,0 +1,231 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Size-class arena for AstNode objects
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2021 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3AstArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(_WIN32) || defined(__MINGW32__)
+#include <malloc.h>  // _aligned_malloc
+#else
+#include <sys/mman.h>  // madvise
+#include <unistd.h>  // sysconf
+#endif
+
+//######################################################################
+
+namespace {
+
+constexpr size_t CHUNK_BYTES = 256 * 1024;  // Also the chunk alignment
+constexpr size_t GRAIN = 16;  // Size class granularity
+constexpr size_t CLASSES = V3AstArena::MAX_BYTES / GRAIN;  // Size classes
+
+struct ArenaChunk final {
+    uint32_t m_blockSize;  // Bytes per block
+    uint32_t m_blocks;  // Blocks in the chunk
+    uint32_t m_carved;  // Blocks handed out at least once
+    uint32_t m_live;  // Blocks allocated
+    uint8_t* m_firstp;  // First block, after the flags
+    uint8_t* flagsp() { return reinterpret_cast<uint8_t*>(this + 1); }
+    uint8_t* blockp(uint32_t n) { return m_firstp + static_cast<size_t>(n) * m_blockSize; }
+    uint32_t blockNum(const void* objp) const {
+        return static_cast<uint32_t>((static_cast<const uint8_t*>(objp) - m_firstp)
+                                     / m_blockSize);
+    }
+    static ArenaChunk* of(const void* objp) {
+        return reinterpret_cast<ArenaChunk*>(reinterpret_cast<uintptr_t>(objp)
+                                             & ~static_cast<uintptr_t>(CHUNK_BYTES - 1));
+    }
+};
+
+struct ArenaFree final {
+    ArenaFree* m_nextp;
+};
+
+struct ArenaClass final {
+    std::mutex m_mutex;  // Only taken while threaded
+    ArenaFree* m_freep = nullptr;  // Free list, blocks freed since carved
+    ArenaChunk* m_carvep = nullptr;  // Chunk blocks are carved from
+    std::vector<ArenaChunk*> m_chunks;  // All chunks of this size class
+};
+
+ArenaClass s_classes[CLASSES];
+bool s_threaded = false;  // Set only while no other thread runs, see V3AstArena::threaded
+std::mutex s_spareMutex;  // Guards s_spares, only taken while threaded
+std::vector<ArenaChunk*> s_spares;  // Trimmed chunks, kept mapped for reuse
+std::atomic<size_t> s_reserved{0};
+std::atomic<size_t> s_reservedPeak{0};
+
+std::unique_lock<std::mutex> lockIfThreaded(std::mutex& mutex) {
+    std::unique_lock<std::mutex> lock{mutex, std::defer_lock};
+    if (s_threaded) lock.lock();
+    return lock;
+}
+
+ArenaChunk* newChunk(size_t blockSize) {
+    ArenaChunk* chunkp = nullptr;
+    {
+        const auto lock = lockIfThreaded(s_spareMutex);
+        if (!s_spares.empty()) {
+            chunkp = s_spares.back();
+            s_spares.pop_back();
+        }
+    }
+    if (!chunkp) {
+        void* memp = nullptr;
+#if defined(_WIN32) || defined(__MINGW32__)
+        memp = _aligned_malloc(CHUNK_BYTES, CHUNK_BYTES);
+#else
+        if (posix_memalign(&memp, CHUNK_BYTES, CHUNK_BYTES)) memp = nullptr;
+#endif
+        if (VL_UNCOVERABLE(!memp)) throw std::bad_alloc{};
+        chunkp = static_cast<ArenaChunk*>(memp);
+    }
+    // Header, a flags byte per block, then the blocks aligned to GRAIN
+    const size_t blocks = (CHUNK_BYTES - sizeof(ArenaChunk) - GRAIN) / (blockSize + 1);
+    chunkp->m_blockSize = static_cast<uint32_t>(blockSize);
+    chunkp->m_blocks = static_cast<uint32_t>(blocks);
+    chunkp->m_carved = 0;
+    chunkp->m_live = 0;
+    const uintptr_t firstp = reinterpret_cast<uintptr_t>(chunkp->flagsp() + blocks);
+    chunkp->m_firstp = reinterpret_cast<uint8_t*>((firstp + GRAIN - 1) & ~(GRAIN - 1));
+    std::memset(chunkp->flagsp(), 0, blocks);
+    const size_t reserved = s_reserved += CHUNK_BYTES;
+    size_t peak = s_reservedPeak;
+    while (peak < reserved && !s_reservedPeak.compare_exchange_weak(peak, reserved)) {}
+    return chunkp;
+}
+
+void spareChunk(ArenaChunk* chunkp) {
+    // Freeing a node zeroed its flags byte, so the chunk reads as holding no
+    // tracked node. It stays mapped for V3Broken to mask stale pointers into,
+    // but the pages past the header go back to the system.
+    s_reserved -= CHUNK_BYTES;
+#if !defined(_WIN32) && !defined(__MINGW32__)
+    static const size_t s_pageBytes = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (s_pageBytes && s_pageBytes < CHUNK_BYTES) {
+        madvise(reinterpret_cast<uint8_t*>(chunkp) + s_pageBytes, CHUNK_BYTES - s_pageBytes,
+                MADV_DONTNEED);
+    }
+#endif
+    const auto lock = lockIfThreaded(s_spareMutex);
+    s_spares.push_back(chunkp);
+}
+
+}  // namespace
+
+//######################################################################
+// V3AstArena class functions
+
+void V3AstArena::threaded(bool flag) { s_threaded = flag; }
+
+void* V3AstArena::alloc(size_t size) {
+    const size_t sizeClass = (size + GRAIN - 1) / GRAIN - 1;
+    ArenaClass& cls = s_classes[sizeClass];
+    const auto lock = lockIfThreaded(cls.m_mutex);
+    if (ArenaFree* const freep = cls.m_freep) {
+        cls.m_freep = freep->m_nextp;
+        ++ArenaChunk::of(freep)->m_live;
+        return freep;
+    }
+    if (!cls.m_carvep || cls.m_carvep->m_carved == cls.m_carvep->m_blocks) {
+        cls.m_carvep = newChunk((sizeClass + 1) * GRAIN);
+        cls.m_chunks.push_back(cls.m_carvep);
+    }
+    ++cls.m_carvep->m_live;
+    return cls.m_carvep->blockp(cls.m_carvep->m_carved++);
+}
+
+void V3AstArena::free(void* objp, size_t size) {
+    ArenaClass& cls = s_classes[(size + GRAIN - 1) / GRAIN - 1];
+    const auto lock = lockIfThreaded(cls.m_mutex);
+    ArenaChunk* const chunkp = ArenaChunk::of(objp);
+    chunkp->flagsp()[chunkp->blockNum(objp)] = 0;
+    --chunkp->m_live;
+    ArenaFree* const freep = static_cast<ArenaFree*>(objp);
+    freep->m_nextp = cls.m_freep;
+    cls.m_freep = freep;
+}
+
+void V3AstArena::trim() {
+    for (ArenaClass& cls : s_classes) {
+        const auto lock = lockIfThreaded(cls.m_mutex);
+        const auto emptyp = [](const ArenaChunk* chunkp) { return !chunkp->m_live; };
+        if (std::none_of(cls.m_chunks.begin(), cls.m_chunks.end(), emptyp)) continue;
+        // Drop the free blocks of the empty chunks, keeping the order of the others
+        ArenaFree** linkpp = &cls.m_freep;
+        while (ArenaFree* const freep = *linkpp) {
+            if (emptyp(ArenaChunk::of(freep))) {
+                *linkpp = freep->m_nextp;
+            } else {
+                linkpp = &freep->m_nextp;
+            }
+        }
+        if (cls.m_carvep && emptyp(cls.m_carvep)) cls.m_carvep = nullptr;
+        const auto it
+            = std::stable_partition(cls.m_chunks.begin(), cls.m_chunks.end(),
+                                    [&](const ArenaChunk* chunkp) { return !emptyp(chunkp); });
+        for (auto delIt = it; delIt != cls.m_chunks.end(); ++delIt) spareChunk(*delIt);
+        cls.m_chunks.erase(it, cls.m_chunks.end());
+    }
+}
+
+uint8_t* V3AstArena::flagsp(const void* objp) {
+    ArenaChunk* const chunkp = ArenaChunk::of(objp);
+    // A stale pointer may mask into a chunk since reused for another size
+    // class, so it need not be at a block of the chunk
+    const uint8_t* const bytep = static_cast<const uint8_t*>(objp);
+    if (bytep < chunkp->m_firstp) return nullptr;
+    const size_t offset = static_cast<size_t>(bytep - chunkp->m_firstp);
+    if (offset % chunkp->m_blockSize
+        || offset >= static_cast<size_t>(chunkp->m_blocks) * chunkp->m_blockSize) {
+        return nullptr;
+    }
+    return chunkp->flagsp() + offset / chunkp->m_blockSize;
+}
+
+void V3AstArena::clearFlags() {
+    for (ArenaClass& cls : s_classes) {
+        const auto lock = lockIfThreaded(cls.m_mutex);
+        for (ArenaChunk* const chunkp : cls.m_chunks) {
+            std::memset(chunkp->flagsp(), 0, chunkp->m_blocks);
+        }
+    }
+}
+
+size_t V3AstArena::bytesLive() {
+    size_t bytes = 0;
+    for (ArenaClass& cls : s_classes) {
+        const auto lock = lockIfThreaded(cls.m_mutex);
+        for (const ArenaChunk* const chunkp : cls.m_chunks) {
+            bytes += static_cast<size_t>(chunkp->m_live) * chunkp->m_blockSize;
+        }
+    }
+    return bytes;
+}
+
+size_t V3AstArena::bytesReserved() { return s_reserved; }
+
+size_t V3AstArena::bytesReservedPeak() { return s_reservedPeak; }
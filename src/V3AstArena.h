@@ -0,0 +1,64 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Size-class arena for AstNode objects
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2021 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3ASTARENA_H_
+#define VERILATOR_V3ASTARENA_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//============================================================================
+// AstNode::operator new/delete allocate from here.
+//
+// Nodes are rounded up to a 16 byte size class and carved from chunks
+// aligned to their size, so the chunk header of a node, holding the live
+// count and a flags byte per block, is found by masking its address. Freed
+// blocks go on a free list per size class and are reused last-in first-out,
+// so the temporary trees V3Const, V3Gate etc. build and delete keep
+// recycling the same memory; trim(), called at each pass boundary, returns
+// the pages of the chunks left without a live node to the system. Every
+// node is in a chunk, and chunks stay mapped once trimmed, so any node
+// pointer, even a stale one, can be masked to its chunk without a lookup,
+// and is bounds checked against the blocks of the chunk.
+// The size classes are only locked while threaded(true).
+
+class V3AstArena final {
+public:
+    static constexpr size_t MAX_BYTES = 512;  ///< Largest node size allocated
+    static void* alloc(size_t size);
+    static void free(void* objp, size_t size);
+    // Return the chunks without a live node to the system
+    static void trim();
+
+    // Whether other threads may allocate, set by V3ThreadPool around its jobs
+    static void threaded(bool flag);
+
+    // V3Broken side table: the flags byte of a node, zero when allocated;
+    // nullptr, not tracked, for a stale pointer not at a block
+    static uint8_t* flagsp(const void* objp);
+    // Zero the flags byte of every node
+    static void clearFlags();
+
+    // Statistics
+    static size_t bytesLive();  ///< Bytes of the nodes allocated
+    static size_t bytesReserved();  ///< Bytes of the chunks held
+    static size_t bytesReservedPeak();  ///< Most bytes of chunks ever held
+};
+
+#endif  // Guard
@@ -28,6 +28,7 @@
 #include "V3AstNodes__gen_macros.h"  // Generated by 'astgen'
 
 #include <iomanip>
+#include <mutex>
 #include <vector>
 
 //======================================================================
@@ -909,6 +910,9 @@ bool AstSenTree::hasCombo() const {
     return false;
 }
 
+// The find functions may be called by concurrent V3ThreadPool jobs
+static std::recursive_mutex s_typeTableMutex;
+
 void AstTypeTable::clearCache() {
     // When we mass-change widthMin in V3WidthCommit, we need to correct the table.
     // Just clear out the maps; the search functions will be used to rebuild the map
@@ -931,6 +935,7 @@ void AstTypeTable::repairCache() {
 }
 
 AstVoidDType* AstTypeTable::findVoidDType(FileLine* fl) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     if (VL_UNLIKELY(!m_voidp)) {
         AstVoidDType* newp = new AstVoidDType(fl);
         addTypesp(newp);
@@ -940,6 +945,7 @@ AstVoidDType* AstTypeTable::findVoidDType(FileLine* fl) {
 }
 
 AstQueueDType* AstTypeTable::findQueueIndexDType(FileLine* fl) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     if (VL_UNLIKELY(!m_queueIndexp)) {
         AstQueueDType* newp = new AstQueueDType(fl, AstNode::findUInt32DType(), nullptr);
         addTypesp(newp);
@@ -949,6 +955,7 @@ AstQueueDType* AstTypeTable::findQueueIndexDType(FileLine* fl) {
 }
 
 AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, AstBasicDTypeKwd kwd) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     if (m_basicps[kwd]) return m_basicps[kwd];
     //
     AstBasicDType* new1p = new AstBasicDType(fl, kwd);
@@ -968,6 +975,7 @@ AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, AstBasicDTypeKwd kwd)
 
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd, int width,
                                                int widthMin, VSigning numeric) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     AstBasicDType* new1p = new AstBasicDType(fl, kwd, numeric, width, widthMin);
     AstBasicDType* newp = findInsertSameDType(new1p);
     if (newp != new1p) {
@@ -981,6 +989,7 @@ AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kw
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd,
                                                const VNumRange& range, int widthMin,
                                                VSigning numeric) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     AstBasicDType* new1p = new AstBasicDType(fl, kwd, numeric, range, widthMin);
     AstBasicDType* newp = findInsertSameDType(new1p);
     if (newp != new1p) {
@@ -992,6 +1001,7 @@ AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kw
 }
 
 AstBasicDType* AstTypeTable::findInsertSameDType(AstBasicDType* nodep) {
+    const std::lock_guard<std::recursive_mutex> lock{s_typeTableMutex};
     VBasicTypeKey key(nodep->width(), nodep->widthMin(), nodep->numeric(), nodep->keyword(),
                       nodep->nrange());
     DetailedMap& mapr = m_detailedMap;
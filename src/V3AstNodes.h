@@ -1936,6 +1936,8 @@ private:
     VVarAttrClocker m_attrClocker;
     MTaskIdSet m_mtaskIds;  // MTaskID's that read or write this var
     bool m_local : 1;
+    bool m_bitSliced : 1;  // RTLflow: --rtlflow-bitslice, lives in the bit-plane pool
+    int m_producerMTaskId;  // RTLflow: lowest MTaskID that writes this var, 0 if none
     size_t m_memLoc;  // only io has memloc, for declaration
 
     void init() {
@@ -1976,6 +1978,8 @@ private:
         m_trace = false;
         m_isLatched = false;
         m_local = false;
+        m_bitSliced = false;
+        m_producerMTaskId = 0;
         m_attrClocker = VVarAttrClocker::CLOCKER_UNKNOWN;
     }
 
@@ -2236,6 +2240,10 @@ public:
     void addProducingMTaskId(int id) { m_mtaskIds.insert(id); }
     void addConsumingMTaskId(int id) { m_mtaskIds.insert(id); }
     const MTaskIdSet& mtaskIds() const { return m_mtaskIds; }
+    void producerMTaskId(int id) {
+        if (!m_producerMTaskId || id < m_producerMTaskId) m_producerMTaskId = id;
+    }
+    int producerMTaskId() const { return m_producerMTaskId; }
     string mtasksString() const;
     void local() { m_local = true; }
     bool isLocal() const { return m_local; }
@@ -2245,6 +2253,8 @@ public:
     }
     void setMemLoc(size_t memLoc) { m_memLoc = memLoc; }
     size_t memLoc() const { return m_memLoc; }
+    void bitSliced(bool flag) { m_bitSliced = flag; }
+    bool bitSliced() const { return m_bitSliced; }
 };
 
 class AstDefParam final : public AstNode {
@@ -2556,6 +2566,7 @@ private:
     size_t m_smem;
     size_t m_imem;
     size_t m_qmem;
+    size_t m_bmem{0};  // Bit planes, --rtlflow-bitslice
     bool m_isCount{false};
 
 public:
@@ -2570,11 +2581,13 @@ public:
     void smem(size_t smem) { m_smem = smem; }
     void imem(size_t imem) { m_imem = imem; }
     void qmem(size_t qmem) { m_qmem = qmem; }
+    void bmem(size_t bmem) { m_bmem = bmem; }
     void isCount(bool count) { m_isCount = count; }
     size_t cmem() const { return m_cmem; }
     size_t smem() const { return m_smem; }
     size_t imem() const { return m_imem; }
     size_t qmem() const { return m_qmem; }
+    size_t bmem() const { return m_bmem; }
     bool isCount() const { return m_isCount; }
 };
 
@@ -8800,6 +8813,8 @@ private:
     bool m_device : 1;  // put to CUDA kernel
     bool m_changeRequest : 1;
     bool m_ctorReset : 1;
+    bool m_simdLanes : 1;  // RTLflow: --rtlflow-simd, evaluates a chunk of stimuli per call
+    bool m_bitSlice : 1;  // RTLflow: --rtlflow-bitslice, evaluates 64 stimuli per word op
 
 public:
     AstCFunc(FileLine* fl, const string& name, AstScope* scopep, const string& rtnType = "")
@@ -8832,6 +8847,8 @@ public:
         m_device = false;
         m_changeRequest = false;
         m_ctorReset = false;
+        m_simdLanes = false;
+        m_bitSlice = false;
     }
     ASTNODE_NODE_FUNCS(CFunc)
     virtual string name() const override { return m_name; }
@@ -8937,6 +8954,14 @@ public:
     void changeRequest(bool isChange) { m_changeRequest = isChange; }
 
     bool changeRequest() const { return m_changeRequest; }
+
+    void simdLanes(bool flag) { m_simdLanes = flag; }
+
+    bool simdLanes() const { return m_simdLanes; }
+
+    void bitSlice(bool flag) { m_bitSlice = flag; }
+
+    bool bitSlice() const { return m_bitSlice; }
 };
 
 // class AstCudaAssign final : public AstNodeStmt {
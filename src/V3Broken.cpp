@@ -27,6 +27,7 @@
 #include "V3Global.h"
 #include "V3Broken.h"
 #include "V3Ast.h"
+#include "V3AstArena.h"
 
 // This visitor does not edit nodes, and is called at error-exit, so should use constant iterators
 #include "V3AstConstOnly.h"
@@ -40,8 +41,10 @@ class BrokenTable VL_NOT_FINAL : public AstNVisitor {
     // Table of brokenExists node pointers
 private:
     // MEMBERS
-    //   For each node, we keep if it exists or not.
-    using NodeMap = std::unordered_map<const AstNode*, int>;  // Performance matters (when --debug)
+    //   For each node, we keep if it exists or not. Without VL_LEAK_CHECKS the
+    //   map is unused, the flags are in the V3AstArena's side table instead,
+    //   zero meaning not tracked.
+    using NodeMap = std::unordered_map<const AstNode*, uint8_t>;  // Performance matters
     static NodeMap s_nodes;  // Set of all nodes that exist
     // BITMASK
     enum { FLAG_ALLOCATED = 0x01 };  // new() and not delete()ed
@@ -50,6 +53,24 @@ private:
     enum { FLAG_LEAKED = 0x08 };  // Known to have been leaked
     enum { FLAG_UNDER_NOW = 0x10 };  // Is in tree as parent of current node
 
+    static uint8_t* findFlags(const AstNode* nodep) {
+#ifndef VL_LEAK_CHECKS
+        if (!nodep) return nullptr;
+        uint8_t* const flagsp = V3AstArena::flagsp(nodep);
+        return flagsp && *flagsp ? flagsp : nullptr;
+#else
+        const auto iter = s_nodes.find(nodep);
+        return iter == s_nodes.end() ? nullptr : &iter->second;
+#endif
+    }
+    static void addFlags(const AstNode* nodep, uint8_t flags) {
+#ifndef VL_LEAK_CHECKS
+        *V3AstArena::flagsp(nodep) = flags;
+#else
+        s_nodes.emplace(nodep, flags);
+#endif
+    }
+
 public:
     // METHODS
     static void deleted(const AstNode* nodep) {
@@ -72,17 +93,16 @@ public:
         UASSERT_OBJ(!(iter != s_nodes.end() && (iter->second & FLAG_ALLOCATED)), nodep,
                     "Newing AstNode object that is already allocated");
         if (iter == s_nodes.end()) {
-            int flags = FLAG_ALLOCATED;  // This int needed to appease GCC 4.1.2
+            uint8_t flags = FLAG_ALLOCATED;  // This variable needed to appease GCC 4.1.2
             s_nodes.emplace(nodep, flags);
         }
     }
     static void setUnder(const AstNode* nodep, bool flag) {
         // Called by BrokenCheckVisitor when each node entered/exited
         if (!okIfLinkedTo(nodep)) return;
-        const auto iter = s_nodes.find(nodep);
-        if (iter != s_nodes.end()) {
-            iter->second &= ~FLAG_UNDER_NOW;
-            if (flag) iter->second |= FLAG_UNDER_NOW;
+        if (uint8_t* const flagsp = findFlags(nodep)) {
+            *flagsp &= ~FLAG_UNDER_NOW;
+            if (flag) *flagsp |= FLAG_UNDER_NOW;
         }
     }
     static void addInTree(AstNode* nodep, bool linkable) {
@@ -90,24 +110,23 @@ public:
         // cppcheck-suppress knownConditionTrueFalse
         if (!linkable) return;  // save some time, else the map will get huge!
 #endif
-        const auto iter = s_nodes.find(nodep);
-        if (VL_UNCOVERABLE(iter == s_nodes.end())) {
+        uint8_t* const flagsp = findFlags(nodep);
+        if (VL_UNCOVERABLE(!flagsp)) {
 #ifdef VL_LEAK_CHECKS
             nodep->v3fatalSrc("AstNode is in tree, but not allocated");
 #endif
         } else {
 #ifdef VL_LEAK_CHECKS
-            UASSERT_OBJ(iter->second & FLAG_ALLOCATED, nodep,
-                        "AstNode is in tree, but not allocated");
+            UASSERT_OBJ(*flagsp & FLAG_ALLOCATED, nodep, "AstNode is in tree, but not allocated");
 #endif
-            UASSERT_OBJ(!(iter->second & FLAG_IN_TREE), nodep,
+            UASSERT_OBJ(!(*flagsp & FLAG_IN_TREE), nodep,
                         "AstNode is already in tree at another location");
         }
-        int or_flags = FLAG_IN_TREE | (linkable ? FLAG_LINKABLE : 0);
-        if (iter == s_nodes.end()) {
-            s_nodes.emplace(nodep, or_flags);
+        const uint8_t or_flags = FLAG_IN_TREE | (linkable ? FLAG_LINKABLE : 0);
+        if (!flagsp) {
+            addFlags(nodep, or_flags);
         } else {
-            iter->second |= or_flags;
+            *flagsp |= or_flags;
         }
     }
     static bool isAllocated(const AstNode* nodep) {
@@ -122,34 +141,35 @@ public:
     }
     static bool okIfLinkedTo(const AstNode* nodep) {
         // Some node in tree has a pointer to this node.  Is it kosher?
-        const auto iter = s_nodes.find(nodep);
-        if (iter == s_nodes.end()) return false;
+        const uint8_t* const flagsp = findFlags(nodep);
+        if (!flagsp) return false;
 #ifdef VL_LEAK_CHECKS
-        if (!(iter->second & FLAG_ALLOCATED)) return false;
+        if (!(*flagsp & FLAG_ALLOCATED)) return false;
 #endif
-        if (!(iter->second & FLAG_IN_TREE)) return false;
-        if (!(iter->second & FLAG_LINKABLE)) return false;
+        if (!(*flagsp & FLAG_IN_TREE)) return false;
+        if (!(*flagsp & FLAG_LINKABLE)) return false;
         return true;
     }
     static bool okIfAbove(const AstNode* nodep) {
         // Must be linked to and below current node
         if (!okIfLinkedTo(nodep)) return false;
-        const auto iter = s_nodes.find(nodep);
-        if (iter == s_nodes.end()) return false;
-        if ((iter->second & FLAG_UNDER_NOW)) return false;
+        const uint8_t* const flagsp = findFlags(nodep);
+        if (!flagsp) return false;
+        if ((*flagsp & FLAG_UNDER_NOW)) return false;
         return true;
     }
     static bool okIfBelow(const AstNode* nodep) {
         // Must be linked to and below current node
         if (!okIfLinkedTo(nodep)) return false;
-        const auto iter = s_nodes.find(nodep);
-        if (iter == s_nodes.end()) return false;
-        if (!(iter->second & FLAG_UNDER_NOW)) return false;
+        const uint8_t* const flagsp = findFlags(nodep);
+        if (!flagsp) return false;
+        if (!(*flagsp & FLAG_UNDER_NOW)) return false;
         return true;
     }
     static void prepForTree() {
 #ifndef VL_LEAK_CHECKS
         s_nodes.clear();
+        V3AstArena::clearFlags();
 #else
         for (NodeMap::iterator it = s_nodes.begin(); it != s_nodes.end(); ++it) {
             it->second &= ~FLAG_IN_TREE;
@@ -24,6 +24,12 @@
 //          module *below*, and it isn't a input to this module,
 //          we need to indicate a new clock has been created.
 //
+// RTLflow: only circular signals, those of a combinational loop or read
+// before they are generated, are detected. Of those, signals that no logic
+// writes, or that no logic reads, cannot require another settle iteration
+// and are pruned. Without any left, the settle loop never iterates and the
+// change request is not emitted at all.
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -33,6 +39,7 @@
 #include "V3Ast.h"
 #include "V3Changed.h"
 #include "V3EmitCBase.h"
+#include "V3Stats.h"
 
 #include <algorithm>
 
@@ -47,6 +54,8 @@ public:
     AstCFunc* m_tlChgFuncp = nullptr;  // Top level change function we're building
     int m_numStmts = 0;  // Number of statements added to m_chgFuncp
     int m_funcNum = 0;  // Number of change functions emitted
+    int m_signals = 0;  // Number of signals detected
+    int m_pruned = 0;  // Number of circular signals not needing detection
 
     ChangedState() = default;
     ~ChangedState() = default;
@@ -227,6 +236,31 @@ public:
     VL_UNCOPYABLE(ChangedInsertVisitor);
 };
 
+//######################################################################
+// Utility visitor to find the read and written variables
+
+class ChangedUsageVisitor final : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist (from ChangedVisitor):
+    //  AstVarScope::user2()            -> int.  USAGE_* bits of the references
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep) override {
+        AstVarScope* vscp = nodep->varScopep();
+        if (!vscp) return;
+        if (nodep->access().isReadOrRW()) vscp->user2(vscp->user2() | USAGE_READ);
+        if (nodep->access().isWriteOrRW()) vscp->user2(vscp->user2() | USAGE_WRITE);
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    enum : int { USAGE_READ = 1, USAGE_WRITE = 2 };
+    // CONSTRUCTORS
+    explicit ChangedUsageVisitor(AstNetlist* nodep) { iterate(nodep); }
+    virtual ~ChangedUsageVisitor() override = default;
+};
+
 //######################################################################
 // Changed state, as a visitor of each AstNode
 
@@ -235,7 +269,9 @@ private:
     // NODE STATE
     // Entire netlist:
     //  AstVarScope::user1()            -> bool.  True indicates processed
+    //  AstVarScope::user2()            -> int.  ChangedUsageVisitor::USAGE_* bits
     AstUser1InUse m_inuser1;
+    AstUser2InUse m_inuser2;
 
     // STATE
     ChangedState* m_statep;  // Shared state across visitors
@@ -245,6 +281,7 @@ private:
 
     void genChangeDet(AstVarScope* vscp) {
         vscp->v3warn(IMPERFECTSCH, "Imperfect scheduling of variable: " << vscp->prettyNameQ());
+        ++m_statep->m_signals;
         ChangedInsertVisitor visitor(vscp, m_statep);
     }
 
@@ -286,7 +323,16 @@ private:
     virtual void visit(AstVarScope* nodep) override {
         if (nodep->isCircular()) {
             UINFO(8, "  CIRC " << nodep << endl);
-            if (!nodep->user1SetOnce()) genChangeDet(nodep);
+            if (nodep->user1SetOnce()) return;
+            // A signal nothing writes cannot change during settling, and one
+            // nothing reads cannot make any logic evaluate again
+            const int both = ChangedUsageVisitor::USAGE_READ | ChangedUsageVisitor::USAGE_WRITE;
+            if ((nodep->user2() & both) != both) {
+                UINFO(8, "  PRUNE " << nodep << endl);
+                ++m_statep->m_pruned;
+                return;
+            }
+            genChangeDet(nodep);
         }
     }
     //--------------------
@@ -297,6 +343,7 @@ public:
     // CONSTRUCTORS
     ChangedVisitor(AstNetlist* nodep, ChangedState* statep)
         : m_statep{statep} {
+        { ChangedUsageVisitor usage{nodep}; }
         iterate(nodep);
     }
     virtual ~ChangedVisitor() override = default;
@@ -312,8 +359,17 @@ void V3Changed::changedAll(AstNetlist* nodep) {
         ChangedVisitor visitor(nodep, &state);
         if (state.m_tlChgFuncp->stmtsp()) {
             state.m_tlChgFuncp->addStmtsp(new AstCStmt(
-                nodep->fileline(), "change[blockDim.x * blockIdx.x + threadIdx.x] = __req;\n"));
+                nodep->fileline(), "change[" + EmitCBaseVisitor::rfTid() + "] = __req;\n"));
+            // RTLflow: the GPU kernels publish one batch-wide bit for the host
+            // to read; the CPU chunks reduce their own lanes
+            if (!v3Global.opt.rtlflowCpu()) {
+                state.m_tlChgFuncp->addStmtsp(
+                    new AstCStmt(nodep->fileline(), "if(__req) *rfAnyChange(_isignals) = 1;\n"));
+            }
         }
+        v3Global.rtlflowChangeDet(state.m_signals != 0);
+        V3Stats::addStat("RTLflow, change detected signals", state.m_signals);
+        V3Stats::addStat("RTLflow, change detection pruned signals", state.m_pruned);
     }  // Destruct before checking
     V3Global::dumpCheckGlobalTree("changed", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
 }
@@ -30,8 +30,11 @@
 #include "V3Width.h"
 #include "V3Simulate.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
 #include <algorithm>
+#include <unordered_set>
+#include <vector>
 
 //######################################################################
 // Utilities
@@ -544,6 +547,7 @@ private:
     AstNode* m_scopep = nullptr;  // Current scope
     AstAttrOf* m_attrp = nullptr;  // Current attribute
     VDouble0 m_statBitOpReduction;  // Ops reduced in ConstBitOpTreeVisitor
+    const std::unordered_set<const AstNodeModule*>* m_doneModsp = nullptr;  // Modules to skip
 
     // METHODS
     VL_DEBUG_FUNC;  // Declare debug()
@@ -1789,6 +1793,7 @@ private:
         iterateChildrenBackwards(nodep);
     }
     virtual void visit(AstNodeModule* nodep) override {
+        if (m_doneModsp && m_doneModsp->count(nodep)) return;  // Constified by a job
         VL_RESTORER(m_modp);
         {
             m_modp = nodep;
@@ -3081,8 +3086,116 @@ public:
         // Operate starting at a random place
         return iterateSubtreeReturnEdits(nodep);
     }
+    void doneModules(const std::unordered_set<const AstNodeModule*>* modsp) {
+        m_doneModsp = modsp;
+    }
+};
+
+//######################################################################
+// Modules that can be constified concurrently
+
+class ConstModulesVisitor final : public AstNVisitor {
+private:
+    // NODE STATE
+    // AstVar::user1p           -> AstNodeModule*.  Module declaring the variable
+    // AstEnumItem::user1p      -> AstNodeModule*.  Module declaring the item
+    AstUser1InUse m_inuser1;
+
+    // STATE
+    AstNodeModule* m_modp = nullptr;  // Current module
+    bool m_marking = true;  // Marking declarations, else checking references
+    std::vector<AstNodeModule*> m_modps;  // All modules, in netlist order
+    std::unordered_set<const AstNodeModule*> m_sharedMods;  // Modules linked to another
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    void checkRef(AstNode* targetp) {
+        // ConstVisitor edits the value of the variable or enum item a
+        // reference points to, so a reference to another module, or to the
+        // type table, links the modules
+        if (m_marking || !m_modp) return;
+        AstNodeModule* const ownerp = targetp ? VN_CAST(targetp->user1p(), NodeModule) : nullptr;
+        if (ownerp == m_modp) return;
+        m_sharedMods.insert(m_modp);
+        if (ownerp) m_sharedMods.insert(ownerp);
+    }
+
+    // VISITORS
+    virtual void visit(AstNetlist* nodep) override { iterateAndNextNull(nodep->modulesp()); }
+    virtual void visit(AstNodeModule* nodep) override {
+        VL_RESTORER(m_modp);
+        {
+            m_modp = nodep;
+            if (m_marking) m_modps.push_back(nodep);
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstVar* nodep) override {
+        if (m_marking) nodep->user1p(m_modp);
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstEnumItem* nodep) override {
+        if (m_marking) nodep->user1p(m_modp);
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNodeVarRef* nodep) override {
+        checkRef(nodep->varp());
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstEnumItemRef* nodep) override {
+        checkRef(nodep->itemp());
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit ConstModulesVisitor(AstNetlist* nodep) {
+        iterate(nodep);
+        m_marking = false;
+        iterate(nodep);
+    }
+    virtual ~ConstModulesVisitor() override = default;
+
+    // Modules not linked to any other, bottom-up like ConstVisitor
+    std::vector<AstNodeModule*> independentModules() const {
+        std::vector<AstNodeModule*> modps;
+        for (auto it = m_modps.rbegin(); it != m_modps.rend(); ++it) {
+            if (!m_sharedMods.count(*it)) modps.push_back(*it);
+        }
+        return modps;
+    }
 };
 
+// Constify each module not linked to another module on its own
+// V3ThreadPool job, then the rest of the netlist serially
+static void constifyModules(AstNetlist* nodep, ConstVisitor::ProcMode pmode) {
+    std::unordered_set<const AstNodeModule*> doneMods;
+    if (V3ThreadPool::threads(2) > 1) {
+        std::vector<AstNodeModule*> modps;
+        {
+            ConstModulesVisitor modsVisitor{nodep};
+            modps = modsVisitor.independentModules();
+        }
+        if (modps.size() > 1) {
+            std::vector<V3ThreadPool::Job> jobs;
+            for (AstNodeModule* modp : modps) {
+                jobs.emplace_back([modp, pmode]() {
+                    ConstVisitor visitor{pmode};
+                    (void)visitor.mainAcceptEdit(modp);
+                });
+            }
+            UINFO(4, "  Constify " << modps.size() << " modules concurrently" << endl);
+            V3ThreadPool::run(jobs);
+            doneMods.insert(modps.begin(), modps.end());
+        }
+    }
+    ConstVisitor visitor{pmode};
+    visitor.doneModules(&doneMods);
+    (void)visitor.mainAcceptEdit(nodep);
+}
+
 //######################################################################
 // Const class functions
 
@@ -3169,20 +3282,14 @@ void V3Const::constifyAllLive(AstNetlist* nodep) {
     // This only pushes constants up, doesn't make any other edits
     // IE doesn't prune dead statements, as we need to do some usability checks after this
     UINFO(2, __FUNCTION__ << ": " << endl);
-    {
-        ConstVisitor visitor(ConstVisitor::PROC_LIVE);
-        (void)visitor.mainAcceptEdit(nodep);
-    }  // Destruct before checking
+    constifyModules(nodep, ConstVisitor::PROC_LIVE);
     V3Global::dumpCheckGlobalTree("const", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
 }
 
 void V3Const::constifyAll(AstNetlist* nodep) {
     // Only call from Verilator.cpp, as it uses user#'s
     UINFO(2, __FUNCTION__ << ": " << endl);
-    {
-        ConstVisitor visitor(ConstVisitor::PROC_V_EXPENSIVE);
-        (void)visitor.mainAcceptEdit(nodep);
-    }  // Destruct before checking
+    constifyModules(nodep, ConstVisitor::PROC_V_EXPENSIVE);
     V3Global::dumpCheckGlobalTree("const", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
 }
 
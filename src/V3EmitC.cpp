@@ -23,12 +23,18 @@
 #include "V3EmitCBase.h"
 #include "V3Number.h"
 #include "V3PartitionGraph.h"
+#include "V3Stats.h"
 #include "V3Task.h"
+#include "V3ThreadPool.h"
 #include "V3TSP.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 constexpr int VL_VALUE_STRING_MAX_WIDTH = 8192;  // We use a static char array in VL_VALUE_STRING
@@ -62,6 +68,17 @@ private:
     int m_labelNum;  // Next label number
     int m_splitSize;  // # of cfunc nodes placed into output file
     int m_splitFilenum;  // File number being created, 0 = primary
+    bool m_rfDisplayArgs = false;  // Emitting the arguments of a --rtlflow-display record
+
+    // Files written, added to the netlist by addCFiles() once the
+    // V3ThreadPool jobs are done, in the same order whatever the scheduling
+    struct PendingCFile {
+        string m_filename;
+        bool m_slow;
+        bool m_source;
+        bool m_support;
+    };
+    std::vector<PendingCFile> m_cfiles;
 
 public:
     // METHODS
@@ -83,11 +100,25 @@ public:
         return (splitSize() && v3Global.opt.outputSplit()
                 && v3Global.opt.outputSplit() < splitSize());
     }
+    void addCFile(const string& filename, bool slow, bool source, bool support = false) {
+        m_cfiles.push_back({filename, slow, source, support});
+    }
+    void addCFiles() {
+        for (const PendingCFile& file : m_cfiles) {
+            AstCFile* cfilep = newCFile(file.m_filename, file.m_slow, file.m_source);
+            cfilep->support(file.m_support);
+        }
+        m_cfiles.clear();
+        // Splitting files, so using parallel build
+        if (m_splitFilenum) v3Global.useParallelBuild(true);
+    }
 
     // METHODS
     void displayNode(AstNode* nodep, AstScopeName* scopenamep, const string& vformat,
                      AstNode* exprsp, bool isScan);
     void displayEmit(AstNode* nodep, bool isScan);
+    void rfDisplayEmit(AstNode* nodep);
+    void rfFinishEmit(AstNode* nodep, const string& what);
     void displayArg(AstNode* dispp, AstNode** elistp, bool isScan, const string& vfmt, bool ignore,
                     char fmtLetter);
 
@@ -261,7 +292,7 @@ public:
 
         for (const AstCFunc* funcp : funcsp) {
             ofp()->putsPrivate(funcp->declPrivate());
-            if (funcp->cudaScope() != "") puts(funcp->cudaScope() + "\n");
+            if (rfCudaScope(funcp) != "") puts(rfCudaScope(funcp) + "\n");
             if (!funcp->ifdef().empty()) puts("#ifdef " + funcp->ifdef() + "\n");
             if (funcp->isStatic().trueUnknown()) puts("static ");
             if (funcp->isVirtual()) puts("virtual ");
@@ -279,7 +310,7 @@ public:
 
 
         for (const AstCFunc* funcp : cudaGlobalsp) {
-            puts("friend __global__ void ");
+            puts("friend " + rfGlobal() + "void ");
             puts(funcNameProtect(funcp, modp));
             puts("(" + cFuncArgs(funcp) + ")");
             puts(";\n");
@@ -295,14 +326,13 @@ public:
                 const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
                 // RTLflow
                 // Emit function declaration for this mtask
-                puts("friend __global__ void ");
+                puts("friend " + rfGlobal() + "void ");
                 puts(protect(mtp->cFuncName()));
                 // RTLflow
                 // puts("(void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals,
                 // QData* "
                 //"_qsignals, IData* change, IData* done);\n");
-                puts("(void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals, QData* "
-                     "_qsignals, IData* change, bool* done);\n");
+                puts("(" + rfMTaskArgs() + ");\n");
             }
             // No AstCFunc for this one, as it's synthetic. Just write it:
             //  RTLflow
@@ -321,6 +351,18 @@ public:
 
     // VISITORS
     virtual void visit(AstNodeAssign* nodep) override {
+        // RTLflow: --rtlflow-bitslice, store a single stimulus bit of a plane
+        if (AstVarRef* lhsVrp = VN_CAST(nodep->lhsp(), VarRef)) {
+            if (lhsVrp->varp()->bitSliced()) {
+                puts("RF_BIT_SET(" + rfBitPlanes() + " + BWORDS * " + cvtToStr(lhsVrp->memLoc())
+                     + ", ");
+                puts(m_isGpu ? rfTid() : "i");
+                puts(", ");
+                iterateAndNextNull(nodep->rhsp());
+                puts(");\n");
+                return;
+            }
+        }
         bool paren = true;
         bool decind = false;
         if (AstSel* selp = VN_CAST(nodep->lhsp(), Sel)) {
@@ -426,6 +468,9 @@ public:
         puts(nodep->funcp()->nameProtect());
         puts("(");
         ccallIterateArgs(nodep);
+        // RTLflow: device functions on the CPU backend evaluate the caller's stimuli
+        const string backendArgs = rfBackendCallArgs(nodep->funcp());
+        if (backendArgs != "") puts(", " + backendArgs);
         if (VN_IS(nodep->backp(), NodeMath) || VN_IS(nodep->backp(), CReturn)) {
             // We should have a separate CCall for math and statement usage, but...
             puts(")");
@@ -519,14 +564,20 @@ public:
         puts(");\n");
     }
     virtual void visit(AstCoverInc* nodep) override {
+        // RTLflow: each stimulus counts in its own element of the bin's
+        // column of the coverage pool, see rf_coverage.h
+        const string elem = "rfCoverage(_isignals)[" + string(m_isGpu ? rfTid() : "i")
+                            + " + THREADS * "
+                            + cvtToStr(nodep->declp()->dataDeclThisp()->binNum()) + "]";
         if (v3Global.opt.threads()) {
-            puts("vlSymsp->__Vcoverage[");
-            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
-            puts("].fetch_add(1, std::memory_order_relaxed);\n");
+            // Mtasks of one stimulus may run concurrently and share a bin
+            if (v3Global.opt.rtlflowCpu()) {
+                puts("__atomic_fetch_add(&" + elem + ", 1, __ATOMIC_RELAXED);\n");
+            } else {
+                puts("atomicAdd(&" + elem + ", 1);\n");
+            }
         } else {
-            puts("++(vlSymsp->__Vcoverage[");
-            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
-            puts("]);\n");
+            puts("++" + elem + ";\n");
         }
     }
     virtual void visit(AstCReturn* nodep) override {
@@ -867,22 +918,9 @@ public:
         iterateAndNextNull(nodep->resultp());
         puts(")");
     }
-    // TODO: use taskflow to stop/finish operations
-    virtual void visit(AstStop* nodep) override {
-        // puts("VL_STOP_MT(");
-        // putsQuoted(protect(nodep->fileline()->filename()));
-        // puts(", ");
-        // puts(cvtToStr(nodep->fileline()->lineno()));
-        // puts(", \"\"");
-        // puts(");\n");
-    }
-    virtual void visit(AstFinish* nodep) override {
-        // puts("VL_FINISH_MT(");
-        // putsQuoted(protect(nodep->fileline()->filename()));
-        // puts(", ");
-        // puts(cvtToStr(nodep->fileline()->lineno()));
-        // puts(", \"\");\n");
-    }
+    // RTLflow: $stop and $finish end the current stimulus only
+    virtual void visit(AstStop* nodep) override { rfFinishEmit(nodep, "$stop"); }
+    virtual void visit(AstFinish* nodep) override { rfFinishEmit(nodep, "$finish"); }
     virtual void visit(AstPrintTimeScale* nodep) override {
         puts("VL_PRINTTIMESCALE(");
         putsQuoted(protect(nodep->name()));
@@ -893,19 +931,27 @@ public:
     virtual void visit(AstRand* nodep) override {
         emitOpName(nodep, nodep->emitC(), nodep->seedp(), nullptr, nullptr);
     }
+    static string timeScale(const VTimescale& timeunit) {
+        return cvtToStr(timeunit.multiplier() / v3Global.rootp()->timeprecision().multiplier());
+    }
     virtual void visit(AstTime* nodep) override {
-        puts("VL_TIME_UNITED_Q(");
         if (nodep->timeunit().isNone()) nodep->v3fatalSrc("$time has no units");
-        puts(cvtToStr(nodep->timeunit().multiplier()
-                      / v3Global.rootp()->timeprecision().multiplier()));
-        puts(")");
+        // RTLflow: in a --rtlflow-display record, the time the host set for it
+        if (m_rfDisplayArgs) {
+            puts("(rfDisplayTime(_qsignals) / static_cast<QData>(" + timeScale(nodep->timeunit())
+                 + "))");
+            return;
+        }
+        puts("VL_TIME_UNITED_Q(" + timeScale(nodep->timeunit()) + ")");
     }
     virtual void visit(AstTimeD* nodep) override {
-        puts("VL_TIME_UNITED_D(");
         if (nodep->timeunit().isNone()) nodep->v3fatalSrc("$realtime has no units");
-        puts(cvtToStr(nodep->timeunit().multiplier()
-                      / v3Global.rootp()->timeprecision().multiplier()));
-        puts(")");
+        if (m_rfDisplayArgs) {
+            puts("(static_cast<double>(rfDisplayTime(_qsignals)) / " + timeScale(nodep->timeunit())
+                 + ")");
+            return;
+        }
+        puts("VL_TIME_UNITED_D(" + timeScale(nodep->timeunit()) + ")");
     }
     virtual void visit(AstTimeFormat* nodep) override {
         puts("VL_TIMEFORMAT_IINI(");
@@ -1185,7 +1231,11 @@ public:
     virtual void visit(AstVarRef* nodep) override {
         auto* varp = nodep->varp();
         AstNodeDType* dtypep{nullptr};
-        if (varp->isCuda()) {
+        if (varp->bitSliced()) {
+            puts("RF_BIT_GET(" + rfBitPlanes() + " + BWORDS * " + cvtToStr(nodep->memLoc()) + ", ");
+            puts(m_isGpu ? rfTid() : "i");
+            puts(")");
+        } else if (varp->isCuda()) {
             // TODO I don't consider the case array of array
             // only consider UnpackedArray
             AstUnpackArrayDType* adtypep = VN_CAST(varp->dtypeSkipRefp(), UnpackArrayDType);
@@ -1213,7 +1263,7 @@ public:
             }
 
             if (m_isGpu) {
-                puts("(blockDim.x * blockIdx.x + threadIdx.x)");
+                puts(rfTid());
             } else {
                 puts("i");
             }
@@ -1432,7 +1482,7 @@ class EmitVarTspSorter final : public V3TSP::TspStateBase {
 private:
     // MEMBERS
     const MTaskIdSet& m_mtaskIds;  // Mtask we're ordering
-    static unsigned s_serialNext;  // Unique ID to establish serial order
+    static std::atomic<unsigned> s_serialNext;  // Unique ID to establish serial order
     unsigned m_serial;  // Serial ordering
 public:
     // CONSTRUCTORS
@@ -1465,7 +1515,7 @@ public:
     }
 };
 
-unsigned EmitVarTspSorter::s_serialNext = 0;
+std::atomic<unsigned> EmitVarTspSorter::s_serialNext{0};
 
 //######################################################################
 // Internal EmitC implementation
@@ -1484,9 +1534,9 @@ class EmitCImp final : public EmitCStmts {
 
     void count_cuda_mem(AstNodeModule* modp);
 
+    int m_addDoubleOr = 10;  // Terms before the next ||, determined experimentally as best
+
     void doubleOrDetect(AstChangeDet* changep, bool& gotOne) {
-        // cppcheck-suppress variableScope
-        static int s_addDoubleOr = 10;  // Determined experimentally as best
         if (!changep->rhsp()) {
             if (!gotOne) {
                 gotOne = true;
@@ -1503,11 +1553,11 @@ class EmitCImp final : public EmitCStmts {
                  word < (changep->lhsp()->isWide() ? changep->lhsp()->widthWords() : 1); ++word) {
                 if (!gotOne) {
                     gotOne = true;
-                    s_addDoubleOr = 10;
+                    m_addDoubleOr = 10;
                     puts("(");
-                } else if (--s_addDoubleOr == 0) {
+                } else if (--m_addDoubleOr == 0) {
                     puts("|| (");
-                    s_addDoubleOr = 10;
+                    m_addDoubleOr = 10;
                 } else {
                     puts(" | (");
                 }
@@ -1534,15 +1584,15 @@ class EmitCImp final : public EmitCStmts {
             // Unfortunately we have some lint checks here, so we can't just skip processing.
             // We should move them to a different stage.
             string filename = VL_DEV_NULL;
-            newCFile(filename, slow, source);
+            addCFile(filename, slow, source);
             ofp = new V3OutCFile(filename);
         } else if (optSystemC()) {
             string filename = filenameNoExt + (source ? ".cpp" : ".h");
-            newCFile(filename, slow, source);
+            addCFile(filename, slow, source);
             ofp = new V3OutScFile(filename);
         } else {
-            string filename = filenameNoExt + (source ? ".cu" : ".h");
-            newCFile(filename, slow, source);
+            string filename = filenameNoExt + (source ? rfSourceExt() : ".h");
+            addCFile(filename, slow, source);
             ofp = new V3OutCFile(filename);
         }
 
@@ -1634,30 +1684,59 @@ class EmitCImp final : public EmitCStmts {
         //}
     }
 
+    // RTLflow: consecutive scalar statements share one loop over the chunk, while
+    // --rtlflow-simd and --rtlflow-bitslice functions are handed the whole chunk
+    void emitMTaskBodyCpu(AstMTaskBody* nodep) {
+        bool inLoop = false;
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            const AstNodeCCall* callp = VN_CAST(stmtp, NodeCCall);
+            const bool chunked
+                = callp && (callp->funcp()->simdLanes() || callp->funcp()->bitSlice());
+            if (chunked && inLoop) {
+                puts("}\n");
+                inLoop = false;
+            } else if (!chunked && !inLoop) {
+                if (v3Global.opt.rtlflowActiveSet()) {
+                    puts("for(size_t k = 0; k < _rf_num_active; ++k) {\n");
+                    puts("size_t i = _rf_active[k];\n");
+                } else {
+                    puts("for(size_t i = _rf_begin; i < _rf_end; ++i) {\n");
+                    puts("if(done[i] || !change[i]) continue;\n");
+                }
+                inLoop = true;
+            }
+            iterate(stmtp);
+        }
+        if (inLoop) puts("}\n");
+    }
+
     virtual void visit(AstMTaskBody* nodep) override {
         maybeSplit();
         splitSizeInc(10);
 
         const ExecMTask* const mtp = nodep->execMTaskp();
         puts("\n");
-        puts("__global__\n");
+        if (rfGlobal() != "") puts(rfGlobal() + "\n");
         puts("void ");
         puts(protect(mtp->cFuncName()));
         // puts("(void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals, QData* "
         //"_qsignals, IData* change, IData* done) {\n");
-        puts("(void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals, QData* "
-             "_qsignals, IData* change, bool* done) {\n");
+        puts("(" + rfMTaskArgs() + ") {\n");
 
         // Declare and set vlSymsp
-        // puts("if(!change[blockDim.x * blockIdx.x + threadIdx.x] || done[blockDim.x * blockIdx.x
-        // + threadIdx.x]) return;\n");
-        puts("if(done[blockDim.x * blockIdx.x + threadIdx.x] || !change[blockDim.x * blockIdx.x + threadIdx.x]) return;\n");
-
         puts(EmitCBaseVisitor::symClassVar() + " = (" + EmitCBaseVisitor::symClassName()
              + "*)symtab;\n");
         puts(EmitCBaseVisitor::symTopAssign() + "\n");
 
-        emitMTaskBody(nodep);
+        // puts("if(!change[blockDim.x * blockIdx.x + threadIdx.x] || done[blockDim.x * blockIdx.x
+        // + threadIdx.x]) return;\n");
+        if (v3Global.opt.rtlflowCpu()) {
+            // RTLflow: one call evaluates a chunk of stimuli
+            emitMTaskBodyCpu(nodep);
+        } else {
+            puts("if(done[" + rfTid() + "] || !change[" + rfTid() + "]) return;\n");
+            emitMTaskBody(nodep);
+        }
         puts("}\n");
     }
 
@@ -1682,7 +1761,7 @@ class EmitCImp final : public EmitCStmts {
         puts("\n");
 
         if (nodep->cudaScope() != "") {
-            puts(nodep->cudaScope() + "\n");
+            if (rfCudaScope(nodep) != "") puts(rfCudaScope(nodep) + "\n");
         } else {
             if (nodep->ifdef() != "") puts("#ifdef " + nodep->ifdef() + "\n");
             if (nodep->isInline()) puts("VL_INLINE_OPT ");
@@ -1715,6 +1794,23 @@ class EmitCImp final : public EmitCStmts {
         // Declare and set vlTOPp
         if (nodep->symProlog()) puts(EmitCBaseVisitor::symTopAssign() + "\n");
 
+        if (nodep->bitSlice()) {
+            emitBitSliceBody(nodep);
+            puts("}\n");
+            m_isGpu = prev_isGpu;
+            return;
+        }
+
+        // RTLflow: kernels on the CPU backend evaluate a chunk of stimuli
+        const bool cpuKernel = rfCpuKernel(nodep) || nodep->simdLanes();
+        if (nodep->simdLanes()) {
+            puts("#pragma omp simd\n");
+            puts("for(size_t i = _rf_begin; i < _rf_end; ++i) {\n");
+            puts("if(done[i] || !change[i]) continue;\n");
+        } else if (cpuKernel) {
+            puts("for(size_t i = _rf_begin; i < _rf_end; ++i) {\n");
+        }
+
         if (nodep->initsp()) putsDecoration("// Variables\n");
         for (AstNode* subnodep = nodep->argsp(); subnodep; subnodep = subnodep->nextp()) {
             if (AstVar* varp = VN_CAST(subnodep, Var)) {
@@ -1748,7 +1844,7 @@ class EmitCImp final : public EmitCStmts {
 
         if (!m_blkChangeDetVec.empty()) puts("return __req;\n");
 
-        if (!nodep->device()) { puts("}\n"); }
+        if (!nodep->device() || cpuKernel) { puts("}\n"); }
 
         // puts("__Vm_activity = true;\n");
         puts("}\n");
@@ -1845,6 +1941,68 @@ class EmitCImp final : public EmitCStmts {
         m_blkChangeDetVec.push_back(nodep);
     }
 
+    // RTLflow: --rtlflow-bitslice
+    // Every statement is a plane assignment evaluated for 64 stimuli per word
+    // operation; the inactive stimuli of the word are masked by _bactive.
+    void emitBitSliceBody(AstCFunc* nodep) {
+        puts("QData* const _bsignals = " + rfBitPlanes() + ";\n");
+        puts("const QData* const _bactive = " + rfBitActive() + ";\n");
+        puts("for(size_t w = _rf_begin >> 6; w < ((_rf_end + 63) >> 6); ++w) {\n");
+        puts("const QData _rf_m = _bactive[w];\n");
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstNodeAssign* assp = VN_CAST(stmtp, NodeAssign);
+            UASSERT_OBJ(assp, stmtp, "Unexpected statement in bit-sliced function");
+            puts("RF_WORD_SET(");
+            emitBitSliceWord(assp->lhsp());
+            puts(", _rf_m, ");
+            emitBitSliceWord(assp->rhsp());
+            puts(");\n");
+        }
+        puts("}\n");
+    }
+    void emitBitSliceWord(AstNode* nodep) {
+        if (AstVarRef* vrefp = VN_CAST(nodep, VarRef)) {
+            puts("_bsignals[w + BWORDS * " + cvtToStr(vrefp->memLoc()) + "]");
+        } else if (AstConst* constp = VN_CAST(nodep, Const)) {
+            puts(constp->isZero() ? "0ULL" : "~0ULL");
+        } else if (AstSel* selp = VN_CAST(nodep, Sel)) {
+            emitBitSliceWord(selp->fromp());
+        } else if (VN_IS(nodep, Not) || VN_IS(nodep, LogNot)) {
+            puts("~");
+            emitBitSliceWord(nodep->op1p());
+        } else if (VN_IS(nodep, Eq)) {
+            puts("~(");
+            emitBitSliceWord(nodep->op1p());
+            puts(" ^ ");
+            emitBitSliceWord(nodep->op2p());
+            puts(")");
+        } else if (AstNodeCond* condp = VN_CAST(nodep, NodeCond)) {
+            puts("((");
+            emitBitSliceWord(condp->condp());
+            puts(" & ");
+            emitBitSliceWord(condp->expr1p());
+            puts(") | (~");
+            emitBitSliceWord(condp->condp());
+            puts(" & ");
+            emitBitSliceWord(condp->expr2p());
+            puts("))");
+        } else {
+            puts("(");
+            emitBitSliceWord(nodep->op1p());
+            if (VN_IS(nodep, And) || VN_IS(nodep, LogAnd)) {
+                puts(" & ");
+            } else if (VN_IS(nodep, Or) || VN_IS(nodep, LogOr)) {
+                puts(" | ");
+            } else if (VN_IS(nodep, Xor) || VN_IS(nodep, Neq)) {
+                puts(" ^ ");
+            } else {
+                nodep->v3fatalSrc("Unexpected node in bit-sliced expression");
+            }
+            emitBitSliceWord(nodep->op2p());
+            puts(")");
+        }
+    }
+
     virtual void visit(AstCReset* nodep) override {
         // AstVar* varp = nodep->varrefp()->varp();
         // if(nodep->varrefp()->scopep() == nullptr) {
@@ -1927,6 +2085,9 @@ class EmitCImp final : public EmitCStmts {
     void emitVarReset(AstVarRef* varRefp) {
         AstVar* varp = varRefp->varp();
         AstNodeDType* const dtypep = varp->dtypep()->skipRefp();
+        // Bit planes are zeroed on allocation, and a per-stimulus reset from the
+        // host loop would race on the shared words
+        if (varp->bitSliced()) return;
 
         AstModule* modp = VN_CAST(m_modp, Module);
         string signals;
@@ -2499,7 +2660,134 @@ struct EmitDispState {
         m_argsp.push_back(nodep);
         m_argsFunc.push_back(func);
     }
-} emitDispState;
+};
+static thread_local EmitDispState emitDispState;  // Per V3ThreadPool job
+
+// RTLflow: --rtlflow-display, host formatting of each recorded format id,
+// the body of a case of the generated rfDisplayFormat(). The ids are
+// numbered in netlist order before emission, so that they do not depend on
+// the order the V3ThreadPool jobs emit the displays in
+static std::unordered_map<const AstNode*, uint32_t> s_rfDisplayIds;
+static std::map<uint32_t, string> s_rfDisplays;
+static std::mutex s_rfDisplaysMutex;
+
+static uint32_t rfDisplayId(const AstNode* nodep) {
+    const auto it = s_rfDisplayIds.find(nodep);
+    UASSERT_OBJ(it != s_rfDisplayIds.end(), nodep, "Display not numbered before emission");
+    return it->second;
+}
+
+static void rfDisplayBody(uint32_t fmt, const string& body) {
+    const std::lock_guard<std::mutex> lock{s_rfDisplaysMutex};
+    s_rfDisplays.emplace(fmt, body);
+}
+
+class rfDisplayNumberer final : public AstNVisitor {
+    void number(AstNode* nodep) {
+        s_rfDisplayIds.emplace(nodep, static_cast<uint32_t>(s_rfDisplayIds.size()));
+    }
+    virtual void visit(AstDisplay* nodep) override { number(nodep); }
+    virtual void visit(AstStop* nodep) override { number(nodep); }
+    virtual void visit(AstFinish* nodep) override { number(nodep); }
+    virtual void visit(AstNodeMath*) override {}  // Accelerate
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    rfDisplayNumberer() {
+        s_rfDisplayIds.clear();
+        s_rfDisplays.clear();
+        iterate(v3Global.rootp());
+    }
+    virtual ~rfDisplayNumberer() override = default;
+};
+
+void EmitCStmts::rfDisplayEmit(AstNode* nodep) {
+    // Append a record to the stimulus' buffer, leaving the formatting to the
+    // host, by VL_SFORMATF_NX with the arguments VL_WRITEF would have taken
+    const EmitDispState& state = emitDispState;
+    for (size_t i = 0; i < state.m_argsp.size(); ++i) {
+        // Strings are not kept in the signal pools
+        if (state.m_argsChar[i] == '@' || state.m_argsFunc[i] == "-1") {
+            nodep->v3warn(E_UNSUPPORTED,
+                          "Unsupported: --rtlflow-display of a string argument");
+            return;
+        }
+    }
+    const uint32_t fmt = rfDisplayId(nodep);
+    string decls;
+    string args = "\"" + V3OutFormatter::quoteNameControls(state.m_format) + "\"";
+    uint32_t words = 0;
+    for (size_t i = 0; i < state.m_argsp.size(); ++i) {
+        AstNode* argp = state.m_argsp[i];
+        const string& func = state.m_argsFunc[i];
+        if (func == "vlSymsp->name()") {
+            args += ", name";
+        } else if (func != "") {
+            args += ", " + func;
+        } else if (!argp) {
+            continue;
+        } else if (const AstTime* timep = VN_CAST(argp, Time)) {
+            // Formatted with the time of the record
+            args += ", (time / static_cast<QData>(" + timeScale(timep->timeunit()) + "))";
+        } else if (const AstTimeD* timep = VN_CAST(argp, TimeD)) {
+            args += ", (static_cast<double>(time) / " + timeScale(timep->timeunit()) + ")";
+        } else if (argp->isWide()) {
+            const string wname = "_rf_w" + cvtToStr(words);
+            decls += "WData " + wname + "[" + cvtToStr(argp->widthWords()) + "];\n";
+            decls += "for(int w = 0; w < " + cvtToStr(argp->widthWords()) + "; ++w) " + wname
+                     + "[w] = recp[" + cvtToStr(words) + " + w];\n";
+            args += ", " + wname;
+            words += argp->widthWords();
+        } else if (argp->isDouble()) {
+            args += ", rfDisplayDouble(recp[" + cvtToStr(words++) + "])";
+        } else if (argp->isQuad()) {
+            args += ", recp[" + cvtToStr(words++) + "]";
+        } else {
+            args += ", static_cast<IData>(recp[" + cvtToStr(words++) + "])";
+        }
+    }
+    rfDisplayBody(fmt, decls + "return VL_SFORMATF_NX(" + args + ");\n");
+
+    puts("if (QData* _rf_recp = rfDisplayRecord(rfDisplay(_qsignals, _isignals), ");
+    puts(m_isGpu ? rfTid() : "i");
+    puts(", " + cvtToStr(fmt) + ", " + cvtToStr(words) + ")) {\n");
+    VL_RESTORER(m_rfDisplayArgs);
+    m_rfDisplayArgs = true;
+    words = 0;
+    for (size_t i = 0; i < state.m_argsp.size(); ++i) {
+        AstNode* argp = state.m_argsp[i];
+        if (!argp || state.m_argsFunc[i] != "" || VN_IS(argp, Time) || VN_IS(argp, TimeD)) {
+            continue;
+        }
+        if (argp->isWide()) {
+            puts("rfDisplayWide(_rf_recp + " + cvtToStr(words) + ", ");
+            iterate(argp);
+            puts(", " + cvtToStr(argp->widthWords()) + ");\n");
+            words += argp->widthWords();
+        } else {
+            puts("_rf_recp[" + cvtToStr(words++) + "] = ");
+            if (argp->isDouble()) puts("rfDisplayBits(");
+            iterate(argp);
+            if (argp->isDouble()) puts(")");
+            puts(";\n");
+        }
+    }
+    puts("}\n");
+}
+
+void EmitCStmts::rfFinishEmit(AstNode* nodep, const string& what) {
+    const string lane = m_isGpu ? rfTid() : "i";
+    if (v3Global.opt.rtlflowDisplay()) {
+        // The message of VL_FINISH_MT/VL_STOP_MT, as a record without arguments
+        const string msg = "- " + protect(nodep->fileline()->filename()) + ":"
+                           + cvtToStr(nodep->fileline()->lineno()) + ": Verilog " + what + "\n";
+        const uint32_t fmt = rfDisplayId(nodep);
+        puts("rfDisplayRecord(rfDisplay(_qsignals, _isignals), " + lane + ", " + cvtToStr(fmt)
+             + ", 0);\n");
+        rfDisplayBody(fmt, "return \"" + V3OutFormatter::quoteNameControls(msg) + "\";\n");
+    }
+    puts("rfDone(_csignals)[" + lane + "] = true;\n");
+}
 
 void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
     if (emitDispState.m_format == ""
@@ -2525,6 +2813,11 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
             puts(",");
         } else if (const AstDisplay* dispp = VN_CAST(nodep, Display)) {
             isStmt = true;
+            if (!dispp->filep() && v3Global.opt.rtlflowDisplay()) {
+                rfDisplayEmit(nodep);
+                emitDispState.clear();
+                return;
+            }
             if (dispp->filep()) {
                 puts("VL_FWRITEF(");
                 iterate(dispp->filep());
@@ -3524,7 +3817,7 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
             }
         }
         for (const AstCFunc* funcp : cudaGlobalsp) {
-            puts("__global__ void ");
+            puts(rfGlobal() + "void ");
             puts(funcNameProtect(funcp, modp));
             puts("(" + cFuncArgs(funcp) + ")");
             puts(";\n");
@@ -3537,10 +3830,9 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
             for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
                  vxp = vxp->verticesNextp()) {
                 const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
-                puts("__global__ void ");
+                puts(rfGlobal() + "void ");
                 puts(protect(mtp->cFuncName()));
-                puts("(void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals, QData* "
-                     "_qsignals, IData* change, bool* done);\n");
+                puts("(" + rfMTaskArgs() + ");\n");
             }
         }
 
@@ -3847,9 +4139,8 @@ void EmitCImp::emitImp(AstNodeModule* modp) {
 void EmitCImp::maybeSplit() {
     if (!splitNeeded()) return;
 
-    // Splitting file, so using parallel build.
-    v3Global.useParallelBuild(true);
     // Close old file
+    m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
     // Open a new file
     m_ofp = newOutCFile(!m_fast, true /*source*/, splitFilenumInc());
@@ -3874,6 +4165,7 @@ void EmitCImp::mainInt(AstNodeModule* modp) {
         m_modp = modp;
     }
     ofp()->putsEndGuard();
+    m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
 }
 
@@ -3918,6 +4210,7 @@ void EmitCImp::mainImp(AstNodeModule* modp, bool slow) {
         }
     }
     puts("} // end of namespace RF ==================================== \n");
+    m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
 }
 
@@ -3927,8 +4220,9 @@ void EmitCImp::mainImp(AstNodeModule* modp, bool slow) {
 class EmitCTrace final : EmitCStmts {
     // NODE STATE/TYPES
     // Cleared on netlist
-    //  AstNode::user1()        -> int.  Enum number
-    AstUser1InUse m_inuser1;
+    //  AstNode::user1()        -> int.  Enum number, slow file only, so that the
+    //                                   fast file can be emitted concurrently
+    std::unique_ptr<AstUser1InUse> m_inuser1p;
 
     // MEMBERS
     AstCFunc* m_cfuncp = nullptr;  // Function we're in now
@@ -3942,10 +4236,9 @@ class EmitCTrace final : EmitCStmts {
             = (v3Global.opt.makeDir() + "/" + topClassName() + "_" + protect("_Trace"));
         if (filenum) filename += "__" + cvtToStr(filenum);
         filename += (m_slow ? "__Slow" : "");
-        filename += ".cu";
+        filename += rfSourceExt();
 
-        AstCFile* cfilep = newCFile(filename, m_slow, true /*source*/);
-        cfilep->support(true);
+        addCFile(filename, m_slow, true /*source*/, true /*support*/);
 
         if (m_ofp) v3fatalSrc("Previous file not closed");
         if (optSystemC()) {
@@ -4268,9 +4561,8 @@ class EmitCTrace final : EmitCStmts {
             m_cfuncp = nodep;
 
             if (splitNeeded()) {
-                // Splitting file, so using parallel build.
-                v3Global.useParallelBuild(true);
                 // Close old file
+                m_ofp->close();
                 VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
                 // Open a new file
                 newOutCFile(splitFilenumInc());
@@ -4362,8 +4654,11 @@ class EmitCTrace final : EmitCStmts {
 
 public:
     explicit EmitCTrace(bool slow)
-        : m_slow{slow} {}
+        : m_slow{slow} {
+        if (m_slow) m_inuser1p.reset(new AstUser1InUse);
+    }
     virtual ~EmitCTrace() override = default;
+    using EmitCStmts::addCFiles;
     void main() {
         // Put out the file
         newOutCFile(0);
@@ -4372,6 +4667,7 @@ public:
 
         iterate(v3Global.rootp());
 
+        m_ofp->close();
         VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
     }
 };
@@ -4415,7 +4711,7 @@ class cudaCheck final : AstNVisitor {
         string signals;
         auto* varp = nodep->varp();
         AstNodeDType* dtypep{nullptr};
-        if (varp->isCuda()) {
+        if (varp->isCuda() && !varp->bitSliced()) {
             if (m_lookup.find(nodep) != m_lookup.end()) { return; }
 
             m_lookup.insert(nodep);
@@ -4535,6 +4831,255 @@ public:
     }
 };
 
+// RTLflow: --rtlflow-simd
+// Checks that a function body only works on CData/SData/IData/QData values of
+// the signal pools or of its own locals, so that its stimulus loop can be
+// vectorized.
+class rfSimdCheck final : public AstNVisitor {
+    bool m_ok = true;
+
+    // VISITORS
+    virtual void visit(AstNodeCCall* nodep) override { m_ok = false; }
+    virtual void visit(AstCReturn* nodep) override { m_ok = false; }
+    virtual void visit(AstCStmt* nodep) override { m_ok = false; }
+    virtual void visit(AstCMath* nodep) override { m_ok = false; }
+    virtual void visit(AstChangeDet* nodep) override { m_ok = false; }
+    virtual void visit(AstCoverInc* nodep) override { m_ok = false; }
+    virtual void visit(AstDisplay* nodep) override { m_ok = false; }
+    virtual void visit(AstSFormatF* nodep) override { m_ok = false; }
+    virtual void visit(AstWhile* nodep) override { m_ok = false; }
+    virtual void visit(AstJumpBlock* nodep) override { m_ok = false; }
+    virtual void visit(AstVarRef* nodep) override {
+        if (!nodep->varp()->isCuda() && !nodep->varp()->isFuncLocal()) m_ok = false;
+        if (nodep->varp()->bitSliced()) m_ok = false;  // Stimuli share plane words
+        if (nodep->isWide() || VN_IS(nodep->varp()->dtypeSkipRefp(), UnpackArrayDType)) {
+            m_ok = false;
+        }
+    }
+    virtual void visit(AstNode* nodep) override {
+        if (!m_ok) return;
+        if (nodep->dtypep() && (nodep->isWide() || nodep->isString())) {
+            m_ok = false;
+            return;
+        }
+        iterateChildren(nodep);
+    }
+
+public:
+    explicit rfSimdCheck(AstCFunc* nodep) { iterateChildren(nodep); }
+    virtual ~rfSimdCheck() override = default;
+    bool ok() const { return m_ok; }
+};
+
+// Marks the device functions only called from mtask bodies whose stimulus
+// loop rfSimdCheck accepts. Their callers hand them a whole chunk of stimuli.
+class rfSimdMarker final : public AstNVisitor {
+    // NODE STATE
+    //  AstCFunc::user1()  -> bool.  Called from outside of an mtask body
+    AstUser1InUse m_inuser1;
+
+    bool m_inMTask = false;
+    std::vector<AstCFunc*> m_candidates;
+
+    // VISITORS
+    virtual void visit(AstMTaskBody* nodep) override {
+        VL_RESTORER(m_inMTask);
+        m_inMTask = true;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNodeCCall* nodep) override {
+        if (!m_inMTask) nodep->funcp()->user1(true);
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstCFunc* nodep) override {
+        if (nodep->device() && nodep->cudaScope() != "__global__" && !nodep->argsp()
+            && nodep->rtnTypeVoid() == "void") {
+            m_candidates.push_back(nodep);
+        }
+        VL_RESTORER(m_inMTask);
+        m_inMTask = false;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    explicit rfSimdMarker() {}
+    virtual ~rfSimdMarker() override = default;
+
+    void mark() {
+        iterate(v3Global.rootp());
+        size_t simdFuncs = 0;
+        for (AstCFunc* funcp : m_candidates) {
+            if (funcp->user1() || funcp->bitSlice() || !rfSimdCheck(funcp).ok()) continue;
+            funcp->simdLanes(true);
+            ++simdFuncs;
+        }
+        V3Stats::addStat("RTLflow, SIMD functions", simdFuncs);
+        V3Stats::addStat("RTLflow, scalar device functions", m_candidates.size() - simdFuncs);
+    }
+};
+
+// RTLflow: --rtlflow-bitslice
+// Moves the single-bit internal signals of the top module into the bit-plane
+// pool when they are only accessed from device functions, and only written by
+// plain assignments. Then marks the functions called from mtask bodies whose
+// statements are all plane assignments of bitwise expressions of planes, so
+// they can be emitted as 64-bit word operations.
+class rfBitSliceMarker final : public AstNVisitor {
+    // NODE STATE
+    //  AstVar::user1()    -> int.  1 = candidate, 2 = rejected
+    //  AstCFunc::user2()  -> bool.  Called from outside of an mtask body
+    AstUser1InUse m_inuser1;
+    AstUser2InUse m_inuser2;
+
+    AstCFunc* m_funcp = nullptr;  // Current function
+    bool m_inMTask = false;
+    std::vector<AstVar*> m_vars;
+    std::vector<AstCFunc*> m_funcps;
+
+    static bool isWordExpr(AstNode* nodep) {
+        if (!nodep->dtypep() || nodep->width() != 1) return false;
+        if (AstVarRef* vrefp = VN_CAST(nodep, VarRef)) return vrefp->varp()->bitSliced();
+        if (VN_IS(nodep, Const)) return true;
+        if (AstSel* selp = VN_CAST(nodep, Sel)) {
+            return VN_IS(selp->lsbp(), Const) && VN_CAST(selp->lsbp(), Const)->isZero()
+                   && isWordExpr(selp->fromp());
+        }
+        if (VN_IS(nodep, Not) || VN_IS(nodep, LogNot)) return isWordExpr(nodep->op1p());
+        if (AstNodeCond* condp = VN_CAST(nodep, NodeCond)) {
+            return isWordExpr(condp->condp()) && isWordExpr(condp->expr1p())
+                   && isWordExpr(condp->expr2p());
+        }
+        if (VN_IS(nodep, And) || VN_IS(nodep, Or) || VN_IS(nodep, Xor) || VN_IS(nodep, LogAnd)
+            || VN_IS(nodep, LogOr) || VN_IS(nodep, Eq) || VN_IS(nodep, Neq)) {
+            return isWordExpr(nodep->op1p()) && isWordExpr(nodep->op2p());
+        }
+        return false;
+    }
+    static bool isWordFunc(AstCFunc* funcp) {
+        if (funcp->initsp() || funcp->finalsp() || !funcp->stmtsp()) return false;
+        for (AstNode* stmtp = funcp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstNodeAssign* assp = VN_CAST(stmtp, NodeAssign);
+            if (!assp || VN_IS(assp, AssignDly)) return false;
+            AstVarRef* lhsVrp = VN_CAST(assp->lhsp(), VarRef);
+            if (!lhsVrp || !lhsVrp->varp()->bitSliced() || !isWordExpr(assp->rhsp())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // VISITORS
+    virtual void visit(AstModule* nodep) override {
+        if (nodep->isTop()) {
+            for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                AstVar* varp = VN_CAST(stmtp, Var);
+                if (!varp || !varp->isCuda() || varp->isIO() || varp->isSigPublic()
+                    || varp->isParam() || varp->isFuncLocal()) {
+                    continue;
+                }
+                const AstBasicDType* basicp = VN_CAST(varp->dtypeSkipRefp(), BasicDType);
+                if (!basicp || basicp->width() != 1) continue;
+                varp->user1(1);
+                m_vars.push_back(varp);
+            }
+        }
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstCFunc* nodep) override {
+        if (nodep->device() && nodep->cudaScope() != "__global__" && !nodep->argsp()
+            && nodep->rtnTypeVoid() == "void") {
+            m_funcps.push_back(nodep);
+        }
+        VL_RESTORER(m_funcp);
+        VL_RESTORER(m_inMTask);
+        m_funcp = nodep;
+        m_inMTask = false;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstMTaskBody* nodep) override {
+        VL_RESTORER(m_inMTask);
+        m_inMTask = true;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNodeCCall* nodep) override {
+        if (!m_inMTask) nodep->funcp()->user2(true);
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstCReset* nodep) override {}  // Planes are zeroed on allocation
+    virtual void visit(AstVarRef* nodep) override {
+        AstVar* varp = nodep->varp();
+        if (varp->user1() != 1) return;
+        if (!m_funcp || !m_funcp->device()) {
+            varp->user1(2);
+        } else if (nodep->access().isWriteOrRW()) {
+            AstNodeAssign* assp = VN_CAST(nodep->backp(), NodeAssign);
+            if (!assp || assp->lhsp() != nodep || VN_IS(assp, AssignDly)) varp->user1(2);
+        }
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    explicit rfBitSliceMarker() {}
+    virtual ~rfBitSliceMarker() override = default;
+
+    void mark() {
+        iterate(v3Global.rootp());
+        size_t bitVars = 0;
+        for (AstVar* varp : m_vars) {
+            if (varp->user1() != 1) continue;
+            varp->bitSliced(true);
+            ++bitVars;
+        }
+        size_t wordFuncs = 0;
+        for (AstCFunc* funcp : m_funcps) {
+            if (funcp->user2() || !isWordFunc(funcp)) continue;
+            funcp->bitSlice(true);
+            ++wordFuncs;
+        }
+        V3Stats::addStat("RTLflow, bit-sliced signals", bitVars);
+        V3Stats::addStat("RTLflow, bit-sliced functions", wordFuncs);
+    }
+};
+
+// RTLflow: --coverage, the bins numbered by EmitCSyms, one column each of
+// the coverage pool
+class rfCoverBinCounter final : public AstNVisitor {
+    size_t m_bins = 0;
+
+    // VISITORS
+    virtual void visit(AstCoverDecl* nodep) override {
+        if (!nodep->dataDeclNullp()) m_bins = std::max<size_t>(m_bins, nodep->binNum() + 1);
+    }
+    virtual void visit(AstNodeMath*) override {}
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    explicit rfCoverBinCounter() { iterate(v3Global.rootp()); }
+    virtual ~rfCoverBinCounter() override = default;
+    size_t bins() const { return m_bins; }
+};
+static size_t s_rfCoverBins = 0;
+
+// RTLflow: --rtlflow-trace, signals of the pools in hierarchy order, as
+// placed by cudaMemAssign for emitRTLflowTrace
+struct RfTraceSig final {
+    string name;  // Pretty hierarchical name, starting with TOP
+    const AstVar* varp;
+    size_t memLoc;
+};
+static std::vector<RfTraceSig> s_rfTraceSigs;
+
+// RTLflow: layout of the pools, for copying one stimulus; runs of
+// back-to-back signals of the same stride, as placed by cudaMemAssign
+struct RfPoolSegment final {
+    int pool;  // 0 CData, 1 SData, 2 IData, 3 QData
+    size_t stride;  // Elements per stimulus
+    size_t memLoc;  // Row of the first signal
+    size_t count;  // Signals
+};
+static std::vector<RfPoolSegment> s_rfPoolSegments;
+
 class cudaMemAssign final : public AstNVisitor {
 
     AstModule* m_modp;
@@ -4542,6 +5087,7 @@ class cudaMemAssign final : public AstNVisitor {
     size_t m_smem = 0;
     size_t m_imem = 0;
     size_t m_qmem = 0;
+    size_t m_bmem = 0;
 
     using Key = std::pair<AstScope*, AstVar*>;
 
@@ -4596,25 +5142,47 @@ class cudaMemAssign final : public AstNVisitor {
 
     size_t countMem(const AstNodeDType* dtypep, AstVar* varp, size_t words) {
         size_t count{0};
-        if (dtypep->widthMin() <= 8) {
+        int pool = 2;
+        if (varp->bitSliced()) {
+            count = m_bmem;
+            m_bmem += words;
+            return count;
+        } else if (dtypep->widthMin() <= 8) {
             count = m_cmem;
             m_cmem += words;
+            pool = 0;
         } else if (dtypep->widthMin() <= 16) {
             count = m_smem;
             m_smem += words;
+            pool = 1;
         } else if (dtypep->isQuad()) {
             count = m_qmem;
             m_qmem += words;
+            pool = 3;
         } else if (dtypep->isWide()) {
             count = m_imem;
-            m_imem += varp->widthWords() * words;
+            words *= varp->widthWords();
+            m_imem += words;
         } else {  // IData
             count = m_imem;
             m_imem += words;
         }
+        addSegment(pool, words, count);
         return count;
     }
 
+    static void addSegment(int pool, size_t stride, size_t memLoc) {
+        for (auto it = s_rfPoolSegments.rbegin(); it != s_rfPoolSegments.rend(); ++it) {
+            if (it->pool != pool) continue;
+            if (it->stride == stride && it->memLoc + it->count * stride == memLoc) {
+                ++it->count;
+                return;
+            }
+            break;
+        }
+        s_rfPoolSegments.push_back({pool, stride, memLoc, 1});
+    }
+
     void sortScps() {
         std::sort(m_scps.begin(), m_scps.end(), [](AstScope* lhs, AstScope* rhs) {
             if (lhs->modp()->level() > rhs->modp()->level()) {
@@ -4627,42 +5195,85 @@ class cudaMemAssign final : public AstNVisitor {
         });
     }
 
-public:
-    cudaMemAssign() {
-        iterate(v3Global.rootp());
+    // Distinct (pool, line) per mtask. Element k of stimulus i is at
+    // k * THREADS + i of its pool; THREADS is only known when the model is
+    // compiled, so the stats take a nominal batch, and count what one warp
+    // of stimuli touches, in 64-byte lines and in 4 KiB pages.
+    static constexpr size_t STAT_THREADS = 1024;
+    static constexpr size_t STAT_WARP = 32;
+    using MTaskLines = std::map<int, std::set<std::pair<int, size_t>>>;
+    struct MTaskFootprint {
+        MTaskLines lines;
+        MTaskLines pages;
+    };
 
-        // top does not belong to cell
-        AstModule* topModp = VN_CAST(v3Global.rootp()->topModulep(), Module);
-        auto& vec = m_modMap[topModp];
-        for (AstVar* varp : vec) {
-            // TODO: I assume we don't have array of array
-            const AstNodeDType* dtypep = varp->dtypep()->skipRefp();
-            size_t loc{0};
-            if (const auto* adtypep = VN_CAST_CONST(dtypep, UnpackArrayDType)) {
-                loc = countMem(adtypep->subDTypep(), varp, adtypep->declRange().elements());
-            } else {
-                loc = countMem(dtypep, varp, 1);
+    void countLines(AstVar* varp, const AstNodeDType* dtypep, size_t loc, size_t words,
+                    MTaskFootprint* footp) {
+        if (varp->bitSliced()) return;
+        int pool;
+        size_t bytes;
+        if (dtypep->widthMin() <= 8) {
+            pool = 0;
+            bytes = 1;
+        } else if (dtypep->widthMin() <= 16) {
+            pool = 1;
+            bytes = 2;
+        } else if (dtypep->isQuad()) {
+            pool = 3;
+            bytes = 8;
+        } else {
+            pool = 2;
+            bytes = 4;
+            if (dtypep->isWide()) words *= varp->widthWords();
+        }
+        for (int id : varp->mtaskIds()) {
+            for (size_t k = loc; k < loc + words; ++k) {
+                const size_t first = k * STAT_THREADS * bytes;
+                const size_t last = first + STAT_WARP * bytes - 1;
+                for (size_t line = first / 64; line <= last / 64; ++line) {
+                    footp->lines[id].insert({pool, line});
+                }
+                for (size_t page = first / 4096; page <= last / 4096; ++page) {
+                    footp->pages[id].insert({pool, page});
+                }
+            }
+        }
+    }
+
+    size_t placeVar(AstVar* varp, MTaskFootprint* footp) {
+        const AstNodeDType* dtypep = varp->dtypep()->skipRefp();
+        size_t words{1};
+        if (const auto* adtypep = VN_CAST_CONST(dtypep, UnpackArrayDType)) {
+            dtypep = adtypep->subDTypep()->skipRefp();
+            words = adtypep->declRange().elements();
+            // The pool accessors index a single unpacked dimension
+            if (VN_IS(dtypep, UnpackArrayDType)) {
+                varp->v3warn(E_UNSUPPORTED,
+                             "Unsupported: RTLflow signal of unpacked arrays of unpacked arrays: "
+                                 << varp->prettyNameQ());
             }
-            varp->setMemLoc(loc);
         }
+        size_t loc = countMem(dtypep, varp, words);
+        if (footp) countLines(varp, dtypep, loc, words, footp);
+        return loc;
+    }
+
+    void assignAll(AstModule* topModp, MTaskFootprint* footp) {
+        m_cmem = m_smem = m_imem = m_qmem = m_bmem = 0;
+        m_memLocMap.clear();
+        s_rfPoolSegments.clear();
+
+        // top does not belong to cell
+        for (AstVar* varp : m_modMap[topModp]) varp->setMemLoc(placeVar(varp, footp));
 
         // scopes
-        sortScps();
         AstModule* prev_modp{nullptr};
         for (AstScope* scp : m_scps) {
             AstModule* cur_modp = VN_CAST(scp->modp(), Module);
 
             auto& vec = m_modMap[cur_modp];
             for (AstVar* varp : vec) {
-
-                // TODO: I assume we don't have array of array
-                const AstNodeDType* dtypep = varp->dtypep()->skipRefp();
-                size_t loc{0};
-                if (const auto* adtypep = VN_CAST_CONST(dtypep, UnpackArrayDType)) {
-                    loc = countMem(adtypep->subDTypep(), varp, adtypep->declRange().elements());
-                } else {
-                    loc = countMem(dtypep, varp, 1);
-                }
+                size_t loc = placeVar(varp, footp);
                 m_memLocMap.insert({{scp, varp}, loc});
 
                 if (prev_modp != cur_modp) {
@@ -4674,10 +5285,102 @@ public:
 
             prev_modp = cur_modp;
         }
+    }
+
+    // Group a module's vars by the mtasks accessing them; vars shared
+    // across mtasks go with their producer. Groups are ordered with the
+    // same TSP used for mtask-mode member sorting; within a group the
+    // declaration order is kept, so the layout is identical for every
+    // instance of the module.
+    static void sortByMTask(std::vector<AstVar*>& vec) {
+        std::map<const MTaskIdSet, std::vector<AstVar*>> groups;
+        for (AstVar* varp : vec) {
+            const MTaskIdSet& ids = varp->mtaskIds();
+            if (ids.size() > 1 && varp->producerMTaskId()) {
+                groups[MTaskIdSet{varp->producerMTaskId()}].push_back(varp);
+            } else {
+                groups[ids].push_back(varp);
+            }
+        }
+        if (groups.size() < 2) return;
+
+        V3TSP::StateVec states;
+        for (const auto& it : groups) states.push_back(new EmitVarTspSorter(it.first));
+        V3TSP::StateVec sorted_states;
+        V3TSP::tspSort(states, &sorted_states);
+
+        vec.clear();
+        for (const V3TSP::TspStateBase* basep : sorted_states) {
+            const EmitVarTspSorter* statep = dynamic_cast<const EmitVarTspSorter*>(basep);
+            const std::vector<AstVar*>& group = groups[statep->mtaskIds()];
+            vec.insert(vec.end(), group.begin(), group.end());
+            VL_DO_DANGLING(delete statep, statep);
+        }
+    }
+
+    static double avgLines(const MTaskLines& lines) {
+        if (lines.empty()) return 0.0;
+        size_t total{0};
+        for (const auto& it : lines) total += it.second.size();
+        return static_cast<double>(total) / lines.size();
+    }
+
+public:
+    cudaMemAssign() {
+        iterate(v3Global.rootp());
+        sortScps();
+
+        AstModule* topModp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+        if (v3Global.opt.rtlflowLocality()) {
+            MTaskFootprint before;
+            assignAll(topModp, &before);
+            for (auto& it : m_modMap) sortByMTask(it.second);
+            MTaskFootprint after;
+            assignAll(topModp, &after);
+            V3Stats::addStat("RTLflow, avg lines per mtask, declaration order",
+                             avgLines(before.lines));
+            V3Stats::addStat("RTLflow, avg lines per mtask, locality order",
+                             avgLines(after.lines));
+            V3Stats::addStat("RTLflow, avg pages per mtask, declaration order",
+                             avgLines(before.pages));
+            V3Stats::addStat("RTLflow, avg pages per mtask, locality order",
+                             avgLines(after.pages));
+        } else {
+            assignAll(topModp, nullptr);
+        }
+
         topModp->cmem(m_cmem);
         topModp->smem(m_smem);
         topModp->imem(m_imem);
         topModp->qmem(m_qmem);
+        topModp->bmem(m_bmem);
+
+        if (v3Global.opt.rtlflowTrace()) collectTrace(topModp);
+    }
+
+    static bool isTraced(const AstVar* varp) {
+        if (varp->bitSliced() || !varp->isSignal() || varp->name().find("__V") != string::npos) {
+            return false;
+        }
+        const AstBasicDType* basicp = varp->basicp();
+        return basicp && !basicp->isOpaque()
+               && !VN_IS(varp->dtypep()->skipRefp(), UnpackArrayDType);
+    }
+
+    void collectTrace(AstModule* topModp) {
+        s_rfTraceSigs.clear();
+        for (AstVar* varp : m_modMap[topModp]) {
+            if (!isTraced(varp)) continue;
+            s_rfTraceSigs.push_back({"TOP." + varp->prettyName(), varp, varp->memLoc()});
+        }
+        for (AstScope* scp : m_scps) {
+            if (scp->modp() == topModp) continue;  // Placed by the top module loop
+            for (AstVar* varp : m_modMap[VN_CAST(scp->modp(), Module)]) {
+                if (!isTraced(varp)) continue;
+                s_rfTraceSigs.push_back({scp->prettyName() + "." + varp->prettyName(), varp,
+                                         m_memLocMap[{scp, varp}]});
+            }
+        }
     }
 
     virtual ~cudaMemAssign() override = default;
@@ -4951,7 +5654,9 @@ private:
     AstNodeModule* m_modp;  // current module
 
     void countMem(const AstNodeDType* dtypep, AstVar* varp, size_t words) {
-        if (dtypep->widthMin() <= 8) {
+        if (varp->bitSliced()) {
+            // Bit-plane pool, only sized for the top module
+        } else if (dtypep->widthMin() <= 8) {
             m_cmem += words;
         } else if (dtypep->widthMin() <= 16) {
             m_smem += words;
@@ -5243,6 +5948,613 @@ public:
 
 // topName is not in this scope
 // we need to find topname to replace hard coded VNV_nvdla
+// RTLflow: column-oriented I/O of the generated RTLflow class
+// A column is the contiguous THREADS * size slab of a port in its pool
+void V3EmitC::emitRTLflowColumnIo(V3OutCFile& of) {
+    const bool cpu = v3Global.opt.rtlflowCpu();
+    const string copy = cpu ? "std::memcpy(" : "checkCuda(cudaMemcpy(";
+    const string asyncCopy = cpu ? "std::memcpy(" : "checkCuda(cudaMemcpyAsync(";
+    const string copyEnd = cpu ? ");\n" : ", cudaMemcpyDefault));\n";
+    const std::vector<std::pair<string, string>> pools{{"CData", "_csignals"},
+                                                       {"SData", "_ssignals"},
+                                                       {"QData", "_qsignals"},
+                                                       {"IData", "_isignals"}};
+    for (const auto& it : pools) {
+        const string& type = it.first;
+        const string bytes = "gpu_threads * loc.size * sizeof(" + type + ")";
+        of.puts("void RTLflow::write(" + type + "Loc loc, const " + type + "* column) {\n");
+        of.puts(copy + it.second + " + loc.memloc, column, " + bytes + copyEnd);
+        of.puts("}\n");
+        of.puts("void RTLflow::read(" + type + "Loc loc, " + type + "* column) const {\n");
+        of.puts(copy + "column, " + it.second + " + loc.memloc, " + bytes + copyEnd);
+        of.puts("}\n");
+        of.puts("void RTLflow::input(" + type + "Loc loc, const " + type + "* columns) {\n");
+        of.puts("_inputs.push_back({" + it.second + " + loc.memloc, const_cast<" + type
+                + "*>(columns), " + bytes + "});\n");
+        of.puts("}\n");
+        of.puts("void RTLflow::output(" + type + "Loc loc, " + type + "* columns) {\n");
+        of.puts("_outputs.push_back({" + it.second + " + loc.memloc, columns, " + bytes + "});\n");
+        of.puts("}\n");
+    }
+    // Streams of a column file hold its cycles only
+    const string cycleCheck
+        = "if(cycle >= s.cycles) {\n"
+          "throw std::runtime_error(\"RTLflow: cycle \" + std::to_string(cycle) + \" beyond "
+          "the \" + std::to_string(s.cycles) + \" cycles of the column file\");\n"
+          "}\n";
+    of.puts("void RTLflow::load(size_t cycle) {\n");
+    of.puts("for(const RfStream& s : _inputs) {\n");
+    of.puts(cycleCheck);
+    of.puts(asyncCopy + "s.signal, static_cast<char*>(s.columns) + cycle * s.bytes, s.bytes"
+            + copyEnd);
+    of.puts("}\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::store(size_t cycle) {\n");
+    of.puts("for(const RfStream& s : _outputs) {\n");
+    of.puts(cycleCheck);
+    of.puts(asyncCopy + "static_cast<char*>(s.columns) + cycle * s.bytes, s.signal, s.bytes"
+            + copyEnd);
+    of.puts("}\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("}\n");
+
+    // Ports of the column files, as declared by RF_IN/RF_OUT in the top class
+    string replay;
+    string record;
+    AstModule* topModp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+    for (AstNode* stmtp = topModp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+        const AstVar* varp = VN_CAST(stmtp, Var);
+        if (!varp || !varp->isIO() || varp->isSc()) continue;
+        const AstBasicDType* basicp = varp->basicp();
+        const AstNodeDType* dtypep = varp->dtypep()->skipRefp();
+        if (!basicp || basicp->isOpaque() || VN_IS(dtypep, UnpackArrayDType)) continue;
+        string type = "IData";
+        string pool = "_isignals";
+        if (varp->isQuad()) {
+            type = "QData";
+            pool = "_qsignals";
+        } else if (varp->widthMin() <= 8) {
+            type = "CData";
+            pool = "_csignals";
+        } else if (varp->widthMin() <= 16) {
+            type = "SData";
+            pool = "_ssignals";
+        }
+        const string words = cvtToStr(varp->isWide() ? varp->widthWords() : 1);
+        const string shape = "\"" + varp->name() + "\", " + cvtToStr(varp->width()) + ", "
+                             + words + ", sizeof(" + type + ")";
+        const string signal = pool + " + " + cvtToStr(varp->memLoc()) + " * gpu_threads";
+        if (varp->isInoutish() || !varp->isWritable()) {
+            replay += "_inputs.push_back(reader.stream(" + shape + ", " + signal + "));\n";
+        }
+        if (varp->isInoutish() || varp->isWritable()) {
+            record += "writer.port(" + shape + ", "
+                      + (varp->isInoutish() ? "RF_COLUMN_INOUT" : "RF_COLUMN_OUT") + ", "
+                      + signal + ");\n";
+        }
+    }
+    of.puts("void RTLflow::replay(const RfColumnReader& reader) {\n");
+    of.puts("if(reader.stimuli() != gpu_threads) {\n");
+    of.puts("throw std::runtime_error(\"RTLflow: column file and batch differ in stimuli\");\n");
+    of.puts("}\n");
+    of.puts(replay);
+    of.puts("}\n");
+    of.puts("void RTLflow::record(RfColumnWriter& writer) {\n");
+    of.puts("if(writer.stimuli() != gpu_threads) {\n");
+    of.puts("throw std::runtime_error(\"RTLflow: column file and batch differ in stimuli\");\n");
+    of.puts("}\n");
+    of.puts(record);
+    of.puts("for(const RfStream& s : writer.open()) _outputs.push_back(s);\n");
+    of.puts("}\n");
+}
+
+// RTLflow: --rtlflow-prof
+void V3EmitC::emitRTLflowProfileIter(V3OutCFile& of) {
+    // Closes the settle-loop iteration numbered loop, checked in the detect task
+    of.puts("{\n");
+    of.puts("vluint64_t now = RfProfiler::ticks();\n");
+    of.puts("_profiler.record(_executor.this_worker_id(), RF_PROF_ITER, loop, 0, _prof_mark, "
+            "now);\n");
+    of.puts("_prof_mark = now;\n");
+    of.puts("}\n");
+}
+
+void V3EmitC::emitRTLflowProfile(V3OutCFile& of) {
+    // Estimated costs, as used by V3Partition, for the summary, and the
+    // mtask hashes that key the measured costs for --rtlflow-prof-cost
+    AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
+    UASSERT_OBJ(execGraphp, v3Global.rootp(), "Root should have an execGraphp");
+    of.puts("bool RTLflow::profile(const std::string& prefix) const {\n");
+    of.puts("static const std::map<uint32_t, uint32_t> costs{\n");
+    for (const V3GraphVertex* vxp = execGraphp->depGraphp()->verticesBeginp(); vxp;
+         vxp = vxp->verticesNextp()) {
+        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+        of.puts("{" + cvtToStr(mtp->id()) + ", " + cvtToStr(mtp->cost()) + "},\n");
+    }
+    of.puts("};\n");
+    of.puts("static const std::map<uint32_t, vluint64_t> hashes{\n");
+    for (const V3GraphVertex* vxp = execGraphp->depGraphp()->verticesBeginp(); vxp;
+         vxp = vxp->verticesNextp()) {
+        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+        of.puts("{" + cvtToStr(mtp->id()) + ", " + cvtToStr(mtp->hash()) + "ULL},\n");
+    }
+    of.puts("};\n");
+    of.puts("return _profiler.writeTrace(prefix + \".json\")\n");
+    of.puts("&& _profiler.writeSummary(prefix + \".txt\", costs)\n");
+    of.puts("&& _profiler.writeCosts(prefix + \".cost\", costs, hashes);\n");
+    of.puts("}\n");
+}
+
+// RTLflow: --coverage, reduction of the coverage pool
+void V3EmitC::emitRTLflowCoverage(V3OutCFile& of) {
+    const bool cpu = v3Global.opt.rtlflowCpu();
+    of.puts("void RTLflow::coverage_reduce(uint32_t* counts) const {\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("rfCoverSum(_covsignals, gpu_threads, cuda_covmem_size, counts);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::coverage_lane(size_t lane, uint32_t* counts) const {\n");
+    of.puts("if(lane >= gpu_threads) throw std::runtime_error(\"RTLflow: coverage lane out of "
+            "range\");\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("rfCoverLane(_covsignals, gpu_threads, cuda_covmem_size, lane, counts);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::coverage_zero() {\n");
+    if (cpu) {
+        of.puts("std::fill_n(_covsignals, gpu_threads * cuda_covmem_size, 0);\n");
+    } else {
+        of.puts("checkCuda(cudaMemset(_covsignals, 0, gpu_threads * cuda_covmem_size * "
+                "sizeof(IData)));\n");
+    }
+    of.puts("}\n");
+}
+
+// RTLflow: --rtlflow-display, host formatting of the buffered records
+void V3EmitC::emitRTLflowDisplay(V3OutCFile& of) {
+    const bool cpu = v3Global.opt.rtlflowCpu();
+    of.puts("static std::string rfDisplayFormat(uint32_t fmt, const char* name, QData time, "
+            "const QData* recp) {\n");
+    of.puts("switch(fmt) {\n");
+    for (const auto& itr : s_rfDisplays) {
+        of.puts("case " + cvtToStr(itr.first) + ": {\n");
+        of.puts(itr.second);
+        of.puts("}\n");
+    }
+    of.puts("default: return \"\";\n");
+    of.puts("}\n");
+    of.puts("}\n");
+    of.puts("size_t RTLflow::display_drain(const std::function<void(size_t, const std::string&)>& "
+            "sink) {\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("size_t records = 0;\n");
+    of.puts("for(size_t i = 0; i < gpu_threads; ++i) {\n");
+    of.puts("const QData* recp = _display.words + i * _display.capacity;\n");
+    of.puts("const QData* endp = recp + _display.heads[i];\n");
+    of.puts("for(; recp < endp; recp += 2 + static_cast<uint32_t>(*recp), ++records) {\n");
+    of.puts("sink(i, rfDisplayFormat(*recp >> 32, _name.c_str(), recp[1], recp + 2));\n");
+    of.puts("}\n");
+    of.puts("if(_display.dropped[i]) {\n");
+    of.puts("sink(i, \"%Warning: RTLflow: \" + std::to_string(_display.dropped[i])\n");
+    of.puts("+ \" $display records dropped, buffer full\\n\");\n");
+    of.puts("}\n");
+    of.puts("_display.heads[i] = 0;\n");
+    of.puts("_display.dropped[i] = 0;\n");
+    of.puts("}\n");
+    of.puts("return records;\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::display_time(vluint64_t time) {\n");
+    of.puts("*_display.time = time;\n");
+    of.puts("}\n");
+    of.puts("size_t RTLflow::display_drain() {\n");
+    of.puts("return display_drain([](size_t i, const std::string& text) {\n");
+    of.puts("std::printf(\"[%zu] %s\", i, text.c_str());\n");
+    of.puts("});\n");
+    of.puts("}\n");
+}
+
+// RTLflow: stimuli still changing after --converge-limit iterations; with
+// --rtlflow-deltas they are retired, otherwise the first one is fatal
+void V3EmitC::emitRTLflowConverge(V3OutCFile& of) {
+    const bool deltas = v3Global.opt.rtlflowDeltas();
+    const string limit = cvtToStr(v3Global.opt.convergeLimit());
+    const FileLine* flp = v3Global.rootp()->topModulep()->fileline();
+    of.puts("void RTLflow::converge_fail() {\n");
+    of.puts("for(size_t i = 0; i < gpu_threads; ++i) {\n");
+    of.puts("if(done[i] || !change[i]) continue;\n");
+    if (deltas) {
+        of.puts("done[i] = true;\n");
+        of.puts("change[i] = 0;\n");
+        of.puts("_unconverged.push_back(i);\n");
+        of.puts("VL_PRINTF_MT(\"%%Warning: RTLflow: stimulus %zu didn't converge in " + limit
+                + " iterations, retired\\n\", i);\n");
+    } else {
+        of.puts("VL_FATAL_MT(");
+        of.putsQuoted(flp->filename());
+        of.puts(", " + cvtToStr(flp->lineno()) + ", \"\",\n");
+        of.puts("(\"Verilated model didn't converge, stimulus \" + std::to_string(i)\n");
+        of.puts("+ \"\\n- See https://verilator.org/warn/DIDNOTCONVERGE\").c_str());\n");
+    }
+    of.puts("}\n");
+    of.puts("}\n");
+    if (!deltas) return;
+    of.puts("std::vector<uint64_t> RTLflow::eval_deltas() const { return _eval_deltas; }\n");
+    of.puts("std::vector<uint64_t> RTLflow::lane_deltas() const {\n");
+    if (v3Global.opt.rtlflowCpu()) {
+        of.puts("return _lane_deltas;\n");
+    } else {
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+        of.puts("return std::vector<uint64_t>(_rf_lane_deltas, _rf_lane_deltas + " + limit
+                + " + 2);\n");
+    }
+    of.puts("}\n");
+}
+
+// RTLflow: _last_assign keeps the __Vclklast copies of the clocks; without
+// any there is nothing to run after the mtasks
+static bool rfLastAssignEmpty() {
+    for (AstNode* nodep = v3Global.rootp()->topModulep()->stmtsp(); nodep;
+         nodep = nodep->nextp()) {
+        const AstCFunc* funcp = VN_CAST(nodep, CFunc);
+        if (funcp && funcp->name() == "_last_assign") {
+            return !funcp->initsp() && !funcp->stmtsp() && !funcp->finalsp();
+        }
+    }
+    return false;
+}
+
+// RTLflow: the end of an evaluation. With a settle loop, the detect tasks
+// branch to it; without one, the initial and the regular evaluation each
+// end in their own copy of it, as a task runs once all its strong
+// dependencies have
+void V3EmitC::emitRTLflowEndBegin(V3OutCFile& of) {
+    if (v3Global.rtlflowChangeDet()) {
+        of.puts("auto end_t = _taskflow.emplace([=](){\n");
+        return;
+    }
+    of.puts("auto end = [=](){\n");
+    of.puts("loop = 1;\n");
+    if (v3Global.opt.rtlflowProf()) emitRTLflowProfileIter(of);
+}
+
+void V3EmitC::emitRTLflowEndFinish(V3OutCFile& of) {
+    if (!v3Global.rtlflowChangeDet()) {
+        of.puts("};\n\n");
+        of.puts("// No circular signal, a single pass settles the batch\n");
+        of.puts("auto init_end_t = _taskflow.emplace(end);\n");
+        of.puts("auto end_t = _taskflow.emplace(end);\n");
+        of.puts("start_t.precede(init_sim_t, sim_t);\n");
+        of.puts("init_sim_t.precede(init_end_t);\n");
+        of.puts("sim_t.precede(end_t);\n");
+        return;
+    }
+    of.puts("});\n\n");
+    of.puts("auto init_detect_t = _taskflow.emplace([=](){\n");
+    emitRTLflowDetect(of);
+    of.puts("});\n");
+    of.puts("auto detect_t = _taskflow.emplace([=](){\n");
+    emitRTLflowDetect(of);
+    of.puts("});\n");
+    of.puts("start_t.precede(init_sim_t, sim_t);\n");
+    of.puts("init_sim_t.precede(init_detect_t);\n");
+    of.puts("init_detect_t.precede(end_t, init_sim_t);\n\n");
+    of.puts("sim_t.precede(detect_t);\n");
+    of.puts("detect_t.precede(end_t, sim_t);\n");
+}
+
+// Detection step of the settle loop: the batch iterates again while any
+// stimulus changed, stimuli that have not converged leave it
+void V3EmitC::emitRTLflowDetect(V3OutCFile& of) {
+    emitRTLflowConvergeCheck(of);
+    if (v3Global.opt.rtlflowProf()) emitRTLflowProfileIter(of);
+    if (v3Global.opt.rtlflowCpu()) {
+        of.puts("return (bool)_any_change;\n");
+    } else {
+        if (v3Global.opt.rtlflowActiveSet()) of.puts("if(*_rf_any_change) compact_active();\n");
+        of.puts("return (bool)*_rf_any_change;\n");
+    }
+}
+
+void V3EmitC::emitRTLflowConvergeCheck(V3OutCFile& of) {
+    of.puts("if(VL_UNLIKELY(++loop > " + cvtToStr(v3Global.opt.convergeLimit()) + ")) {\n");
+    of.puts("converge_fail();\n");
+    of.puts("return 0;\n");
+    of.puts("}\n");
+}
+
+// RTLflow: reduction of the done flags, for the driver loop to stop early
+void V3EmitC::emitRTLflowAllDone(V3OutCFile& of) {
+    of.puts("bool RTLflow::all_done() {\n");
+    if (v3Global.opt.rtlflowCpu()) {
+        of.puts("IData all = 1;\n");
+        of.puts("for(size_t i = 0; i < gpu_threads; ++i) all &= done[i];\n");
+        of.puts("return all;\n");
+    } else {
+        of.puts("*_rf_all = 1;\n");
+        of.puts("_rf_all_done<<<dim3((gpu_threads + 127) / 128, 1, 1), dim3(128, 1, 1), 0>>>("
+                "done, gpu_threads, _rf_all);\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+        of.puts("return *_rf_all;\n");
+    }
+    of.puts("}\n");
+}
+
+// RTLflow: coverage-directed retirement of stimuli
+void V3EmitC::emitRTLflowRetire(V3OutCFile& of) {
+    of.puts("std::vector<size_t> RTLflow::retire(RfRetirer& retirer) {\n");
+    of.puts("if(retirer.stimuli() != gpu_threads) throw std::runtime_error(\"RTLflow: retirer "
+            "and batch differ in stimuli\");\n");
+    if (!v3Global.opt.rtlflowCpu()) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    if (v3Global.opt.coverage()) of.puts("retirer.credit(_covsignals, cuda_covmem_size);\n");
+    of.puts("return retirer.retire(done, change);\n");
+    of.puts("}\n");
+}
+
+// RTLflow: checkpoints
+void V3EmitC::emitRTLflowCheckpoint(V3OutCFile& of) {
+    const bool cpu = v3Global.opt.rtlflowCpu();
+    const bool bits = v3Global.opt.rtlflowBitslice();
+    of.puts("static const std::vector<RfSegment> rfSegments{\n");
+    static const char* const pools[] = {"RF_POOL_C", "RF_POOL_S", "RF_POOL_I", "RF_POOL_Q"};
+    for (const RfPoolSegment& seg : s_rfPoolSegments) {
+        of.puts(string("{") + pools[seg.pool] + ", " + cvtToStr(seg.stride) + ", "
+                + cvtToStr(seg.memLoc) + ", " + cvtToStr(seg.count) + "},\n");
+    }
+    of.puts("};\n");
+    of.puts("RfBatch RTLflow::batch() const {\n");
+    of.puts("return {{_csignals, _ssignals, _isignals, _qsignals, "
+            + string(bits ? "_bsignals" : "nullptr") + "},\n");
+    of.puts("{cuda_cmem_size, cuda_smem_size, cuda_imem_size, cuda_qmem_size, "
+            + string(bits ? "cuda_bmem_size" : "0") + "},\n");
+    of.puts("change, done, gpu_threads};\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::restored(bool initialized) {\n");
+    of.puts("init = initialized;\n");
+    if (!cpu) {
+        of.puts("int device;\n");
+        of.puts("checkCuda(cudaGetDevice(&device));\n");
+        of.puts("const RfBatch b = batch();\n");
+        of.puts("for(uint32_t p = 0; p < 4; ++p) {\n");
+        of.puts("if(b.poolBytes(p)) checkCuda(cudaMemPrefetchAsync(b.pools[p], b.poolBytes(p), "
+                "device));\n");
+        of.puts("}\n");
+        of.puts("checkCuda(cudaMemPrefetchAsync(change, gpu_threads * sizeof(IData), device));\n");
+        of.puts("checkCuda(cudaMemPrefetchAsync(done, gpu_threads * sizeof(bool), device));\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    }
+    of.puts("}\n");
+    of.puts("void RTLflow::save(const std::string& path) const {\n");
+    if (!cpu) of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    of.puts("RfCheckpoint::save(path, batch(), init);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::restore(const std::string& path) {\n");
+    of.puts("RfCheckpoint ckpt{path};\n");
+    of.puts("ckpt.restore(batch());\n");
+    of.puts("restored(ckpt.header().init);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::restore(const std::string& path, const std::vector<size_t>& lanes) "
+            "{\n");
+    of.puts("RfCheckpoint ckpt{path};\n");
+    of.puts("ckpt.restore(batch(), lanes, rfSegments.data(), rfSegments.size());\n");
+    of.puts("restored(init);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::broadcast(const std::string& path, size_t from) {\n");
+    of.puts("RfCheckpoint ckpt{path};\n");
+    of.puts("ckpt.broadcast(batch(), from, 0, gpu_threads, rfSegments.data(), "
+            "rfSegments.size());\n");
+    of.puts("restored(ckpt.header().init);\n");
+    of.puts("}\n");
+
+    // Fork: broadcast one stimulus in place, row by row over the pools
+    if (!cpu) {
+        of.puts("// blockIdx.y: segment, or the change/done vectors past the last one\n");
+        of.puts("__global__ void _rf_fork(const RfSegment* segs, size_t nsegs, "
+                "CData* _csignals, SData* _ssignals, IData* _isignals, QData* _qsignals, "
+                "IData* change, bool* done, size_t stimuli, size_t from, size_t begin, "
+                "size_t end) {\n");
+        of.puts("const size_t lanes = end - begin;\n");
+        of.puts("const size_t first = blockDim.x * blockIdx.x + threadIdx.x;\n");
+        of.puts("const size_t step = blockDim.x * gridDim.x;\n");
+        of.puts("// Segment y, or the flags for y == nsegs, striding over gridDim.y\n");
+        of.puts("for(size_t y = blockIdx.y; y <= nsegs; y += gridDim.y) {\n");
+        of.puts("if(y == nsegs) {\n");
+        of.puts("for(size_t k = first; k < lanes; k += step) {\n");
+        of.puts("if(begin + k == from) continue;\n");
+        of.puts("change[begin + k] = change[from];\n");
+        of.puts("done[begin + k] = done[from];\n");
+        of.puts("}\n");
+        of.puts("continue;\n");
+        of.puts("}\n");
+        of.puts("const RfSegment seg = segs[y];\n");
+        of.puts("const size_t per = seg.stride * lanes;\n");
+        of.puts("for(size_t k = first; k < seg.count * per; k += step) {\n");
+        of.puts("const size_t lane = begin + k % per / seg.stride;\n");
+        of.puts("if(lane == from) continue;\n");
+        of.puts("const size_t base = (seg.memLoc + k / per * seg.stride) * stimuli + "
+                "k % seg.stride;\n");
+        of.puts("const size_t to = base + lane * seg.stride;\n");
+        of.puts("const size_t at = base + from * seg.stride;\n");
+        of.puts("switch(seg.pool) {\n");
+        of.puts("case RF_POOL_C: _csignals[to] = _csignals[at]; break;\n");
+        of.puts("case RF_POOL_S: _ssignals[to] = _ssignals[at]; break;\n");
+        of.puts("case RF_POOL_I: _isignals[to] = _isignals[at]; break;\n");
+        of.puts("default: _qsignals[to] = _qsignals[at]; break;\n");
+        of.puts("}\n");
+        of.puts("}\n");
+        of.puts("}\n");
+        of.puts("}\n");
+    }
+    of.puts("void RTLflow::fork(size_t from, size_t begin, size_t end) {\n");
+    of.puts("if(from >= gpu_threads || begin > end || end > gpu_threads) {\n");
+    of.puts("throw std::runtime_error(\"RTLflow: lane out of range\");\n");
+    of.puts("}\n");
+    if (cpu) {
+        of.puts("const RfBatch b = batch();\n");
+        of.puts("rfBroadcastLane(b, begin, end, b, from, rfSegments.data(), "
+                "rfSegments.size());\n");
+    } else {
+        of.puts("if(begin == end) return;\n");
+        of.puts("if(!_rf_segments && !rfSegments.empty()) {\n");
+        of.puts("checkCuda(cudaMallocManaged(&_rf_segments, rfSegments.size() * "
+                "sizeof(RfSegment)));\n");
+        of.puts("std::copy(rfSegments.begin(), rfSegments.end(), _rf_segments);\n");
+        of.puts("}\n");
+        // gridDim.y is limited to 65535, larger designs loop over the segments
+        of.puts("_rf_fork<<<dim3(std::min<size_t>(1024, (end - begin + 255) / 256), "
+                "std::min<size_t>(65535, rfSegments.size() + 1), 1), dim3(256, 1, 1)>>>("
+                "_rf_segments, rfSegments.size(), _csignals, _ssignals, _isignals, _qsignals, "
+                "change, done, gpu_threads, from, begin, end);\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    }
+    of.puts("}\n");
+}
+
+// RTLflow: --rtlflow-trace
+void V3EmitC::emitRTLflowTrace(V3OutCFile& of) {
+    const bool cpu = v3Global.opt.rtlflowCpu();
+    of.puts("static const std::vector<RfTraceSignal> rfTraceSignals{\n");
+    for (const RfTraceSig& sig : s_rfTraceSigs) {
+        const AstVar* varp = sig.varp;
+        string pool = "RF_TRACE_IDATA";
+        if (varp->isQuad()) {
+            pool = "RF_TRACE_QDATA";
+        } else if (varp->widthMin() <= 8) {
+            pool = "RF_TRACE_CDATA";
+        } else if (varp->widthMin() <= 16) {
+            pool = "RF_TRACE_SDATA";
+        }
+        const AstBasicDType* basicp = VN_CAST(varp->dtypep()->skipRefp(), BasicDType);
+        const int lsb = basicp ? basicp->lo() : 0;
+        of.puts("{\"" + sig.name + "\", " + cvtToStr(lsb + varp->width() - 1) + ", "
+                + cvtToStr(lsb) + ", " + pool + ", "
+                + cvtToStr(varp->isWide() ? varp->widthWords() : 1) + ", " + cvtToStr(sig.memLoc)
+                + "},\n");
+    }
+    of.puts("};\n");
+    const string timescale = v3Global.rootp()->timeprecision().ascii();
+    if (!cpu) {
+        of.puts("__global__ void _rf_trace_gather(const RfTraceEntry* entries, size_t n, "
+                "const size_t* lanes, size_t nlanes, const CData* _csignals, "
+                "const SData* _ssignals, const IData* _isignals, const QData* _qsignals, "
+                "QData* out) {\n");
+        of.puts("size_t k = blockDim.x * blockIdx.x + threadIdx.x;\n");
+        of.puts("if(k >= n * nlanes) return;\n");
+        of.puts("const RfTraceEntry& e = entries[k % n];\n");
+        of.puts("size_t at = e.offset + lanes[k / n] * e.stride;\n");
+        of.puts("switch(e.pool) {\n");
+        of.puts("case RF_TRACE_CDATA: out[k] = _csignals[at]; break;\n");
+        of.puts("case RF_TRACE_SDATA: out[k] = _ssignals[at]; break;\n");
+        of.puts("case RF_TRACE_IDATA: out[k] = _isignals[at]; break;\n");
+        of.puts("default: out[k] = _qsignals[at]; break;\n");
+        of.puts("}\n");
+        of.puts("}\n");
+    }
+    of.puts("void RTLflow::trace_open(const std::vector<size_t>& lanes, "
+            "const std::string& prefix, const std::string& suffix) {\n");
+    of.puts("trace_close();\n");
+    of.puts("_tracer.reset(new RfLaneTracer{rfTraceSignals.data(), rfTraceSignals.size(), "
+            "gpu_threads, lanes, prefix, suffix, \"" + timescale + "\"});\n");
+    if (!cpu) {
+        of.puts("const std::vector<RfTraceEntry>& entries = _tracer->entries();\n");
+        of.puts("if(entries.empty() || lanes.empty()) return;\n");
+        of.puts("checkCuda(cudaMallocManaged(&_trace_entries, entries.size() * "
+                "sizeof(RfTraceEntry)));\n");
+        of.puts("checkCuda(cudaMallocManaged(&_trace_lanes, lanes.size() * sizeof(size_t)));\n");
+        of.puts("checkCuda(cudaMallocManaged(&_trace_buffer, entries.size() * lanes.size() * "
+                "sizeof(QData)));\n");
+        of.puts("std::copy(entries.begin(), entries.end(), _trace_entries);\n");
+        of.puts("std::copy(lanes.begin(), lanes.end(), _trace_lanes);\n");
+    }
+    of.puts("}\n");
+    of.puts("void RTLflow::trace_dump(vluint64_t time) {\n");
+    of.puts("if(!_tracer) return;\n");
+    if (cpu) {
+        of.puts("_tracer->gather(_csignals, _ssignals, _isignals, _qsignals);\n");
+    } else {
+        of.puts("size_t n = _tracer->entries().size() * _tracer->lanes().size();\n");
+        of.puts("if(n) {\n");
+        of.puts("_rf_trace_gather<<<(n + 255) / 256, 256>>>(_trace_entries, "
+                "_tracer->entries().size(), _trace_lanes, _tracer->lanes().size(), _csignals, "
+                "_ssignals, _isignals, _qsignals, _trace_buffer);\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+        of.puts("std::copy(_trace_buffer, _trace_buffer + n, _tracer->buffer());\n");
+        of.puts("}\n");
+    }
+    of.puts("_tracer->dump(time);\n");
+    of.puts("}\n");
+    of.puts("void RTLflow::trace_close() {\n");
+    of.puts("_tracer.reset();\n");
+    if (!cpu) {
+        of.puts("checkCuda(cudaFree(_trace_entries));\n");
+        of.puts("checkCuda(cudaFree(_trace_lanes));\n");
+        of.puts("checkCuda(cudaFree(_trace_buffer));\n");
+        of.puts("_trace_entries = nullptr;\n");
+        of.puts("_trace_lanes = nullptr;\n");
+        of.puts("_trace_buffer = nullptr;\n");
+    }
+    of.puts("}\n");
+}
+
+// RTLflow: per-model state past the signals of the pools, the done flags
+// after the CData signals, the any-change word, the active lanes, the
+// display counts and the coverage columns after the IData signals, and the
+// display time and records after the QData signals and bit planes. The
+// generated code finds it from its pool arguments, so each RTLflow object
+// keeps its own.
+static string rfIntStateWords() {  // For gpu_threads stimuli
+    string words = "1";
+    if (v3Global.opt.rtlflowActiveSet() && !v3Global.opt.rtlflowCpu()) words += " + gpu_threads";
+    if (v3Global.opt.rtlflowDisplay()) words += " + 2 * gpu_threads";
+    if (v3Global.opt.coverage()) words += " + gpu_threads * cuda_covmem_size";
+    return words;
+}
+static string rfQuadStateWords() {  // For gpu_threads stimuli, "" if none
+    string words;
+    if (v3Global.opt.rtlflowBitslice()) words = "(gpu_threads + 63) / 64 * (cuda_bmem_size + 1)";
+    if (v3Global.opt.rtlflowDisplay()) {
+        words += string(words.empty() ? "" : " + ") + "1 + gpu_threads * RF_DISPLAY_WORDS";
+    }
+    return words;
+}
+
+void V3EmitC::emitRTLflowState(V3OutCFile& of) {
+    const AstModule* topp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+    const string qual = v3Global.opt.rtlflowCpu() ? "inline " : "__host__ __device__ inline ";
+    const string ints = "_isignals + THREADS * " + cvtToStr(topp->imem());
+    string quads = "_qsignals + THREADS * " + cvtToStr(topp->qmem());
+    if (v3Global.opt.rtlflowBitslice()) quads += " + BWORDS * " + cvtToStr(topp->bmem() + 1);
+    of.puts("// Per-model state past the signals of the pools, where the generated\n");
+    of.puts("// code finds it from its pool arguments\n");
+    of.puts("// Done flag of each stimulus, set by $finish and $stop\n");
+    of.puts(qual + "bool* rfDone(CData* _csignals) {\n");
+    of.puts("return reinterpret_cast<bool*>(_csignals + THREADS * " + cvtToStr(topp->cmem())
+            + ");\n");
+    of.puts("}\n");
+    of.puts("// Set when any stimulus changed in the last iteration\n");
+    of.puts(qual + "IData* rfAnyChange(IData* _isignals) { return " + ints + "; }\n");
+    string at = ints + " + 1";
+    if (v3Global.opt.rtlflowActiveSet() && !v3Global.opt.rtlflowCpu()) {
+        of.puts("// Stimulus of each thread, the active stimuli first\n");
+        of.puts(qual + "IData* rfActive(IData* _isignals) { return " + at + "; }\n");
+        at += " + THREADS";
+    }
+    if (v3Global.opt.rtlflowDisplay()) {
+        of.puts("// $display records of each stimulus, after the time the host set\n");
+        of.puts(qual + "RfDisplayRing rfDisplay(QData* _qsignals, IData* _isignals) {\n");
+        of.puts("QData* const timep = " + quads + ";\n");
+        of.puts("IData* const countsp = " + at + ";\n");
+        of.puts("return RfDisplayRing{timep + 1, countsp, countsp + THREADS, RF_DISPLAY_WORDS, "
+                "timep};\n");
+        of.puts("}\n");
+        of.puts(qual + "QData rfDisplayTime(const QData* _qsignals) { return *(" + quads
+                + "); }\n");
+        at += " + 2 * THREADS";
+    }
+    if (v3Global.opt.coverage()) {
+        of.puts("// Coverage pool, stimulus i of bin b at b * THREADS + i\n");
+        of.puts(qual + "IData* rfCoverage(IData* _isignals) { return " + at + "; }\n");
+    }
+}
+
 void V3EmitC::emitRTLflowInt(size_t cuda_cmem_size, size_t cuda_smem_size, size_t cuda_imem_size,
                              size_t cuda_qmem_size) {
     string fileDir = v3Global.opt.makeDir() + "/";
@@ -5261,50 +6573,213 @@ void V3EmitC::emitRTLflowInt(size_t cuda_cmem_size, size_t cuda_smem_size, size_
     of.putsGuard();
     of.puts("\n#include <taskflow.hpp>\n");
     of.puts("\n#include <rf_heavy.h>\n");
-    of.puts("\n#include <cuda/cudaflow.hpp>\n");
+    of.puts("\n#include <rf_columns.h>\n");
+    of.puts("\n#include <rf_checkpoint.h>\n");
+    of.puts("\n#include <rf_retire.h>\n");
+    if (v3Global.opt.rtlflowProf()) of.puts("\n#include <rf_profile.h>\n");
+    if (v3Global.opt.rtlflowTrace()) of.puts("\n#include <rf_trace.h>\n");
+    if (v3Global.opt.coverage()) of.puts("\n#include <rf_coverage.h>\n");
+    if (v3Global.opt.rtlflowDisplay()) of.puts("\n#include <rf_display.h>\n");
+    if (v3Global.opt.rtlflowDisplay()) of.puts("\n#include <functional>\n");
+    of.puts("\n#include <memory>\n");
+    of.puts("\n#include <vector>\n");
+    if (!v3Global.opt.rtlflowCpu()) of.puts("\n#include <cuda/cudaflow.hpp>\n");
 
     of.puts("// begin of namespace RF =====================================\n");
     of.puts("namespace RF {\n");
     // of.puts("#include \""+ topClassName + ".h\"\n");
     of.puts("class " + topClassName + "__Syms;\n");
     of.puts("class " + topClassName + ";\n");
+    emitRTLflowState(of);
     of.puts("class RTLflow {\n\n");
     of.puts("friend class " + topClassName + ";\n");
     of.putsPrivate(true);
     of.puts("tf::Taskflow _taskflow;\n");
-    of.puts("tf::cudaFlow _cudaflow;\n");
-    of.puts("tf::Executor _executor{8};\n");
+    if (v3Global.opt.rtlflowCpu()) {
+        of.puts("tf::Taskflow _initflow;\n");
+        of.puts("tf::Taskflow _simflow;\n");
+        of.puts("tf::Executor _executor;\n");
+        of.puts("IData _any_change{0};\n");
+        of.puts("IData* _rf_chunk_change{nullptr};  // Any change, per chunk\n");
+    } else {
+        of.puts("tf::cudaFlow _cudaflow;\n");
+        of.puts("tf::Executor _executor{8};\n");
+    }
     of.puts("size_t cuda_cmem_size{" + cvtToStr(cuda_cmem_size) + "};\n");
     of.puts("size_t cuda_smem_size{" + cvtToStr(cuda_smem_size) + "};\n");
     of.puts("size_t cuda_imem_size{" + cvtToStr(cuda_imem_size) + "};\n");
     of.puts("size_t cuda_qmem_size{" + cvtToStr(cuda_qmem_size) + "};\n");
+    if (v3Global.opt.rtlflowBitslice()) {
+        AstModule* topp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+        of.puts("size_t cuda_bmem_size{" + cvtToStr(topp->bmem()) + "};\n");
+    }
+    if (v3Global.opt.rtlflowDisplay()) {
+        of.puts("RfDisplayRing _display{};  // Past the signals of the pools\n");
+        of.puts("std::string _name{\"TOP\"};  // Of the model, for %m\n");
+    }
+    if (v3Global.opt.coverage()) {
+        of.puts("size_t cuda_covmem_size{" + cvtToStr(s_rfCoverBins) + "};\n");
+        of.puts("IData* _covsignals{nullptr};  // Past the IData signals\n");
+    }
+    if (v3Global.opt.rtlflowActiveSet()) {
+        if (v3Global.opt.rtlflowCpu()) {
+            of.puts("IData* _rf_lanes{nullptr};\n");
+            of.puts("size_t* _rf_num_active{nullptr};\n");
+        } else {
+            of.puts("IData* _rf_lanes{nullptr};  // Past the IData signals\n");
+            of.puts("IData* _rf_next{nullptr};\n");
+            of.puts("IData* _rf_counts{nullptr};\n");
+        }
+    }
     of.puts("size_t gpu_threads;\n");
     of.puts("size_t ast_size{" + cvtToStr(counter.total_count) + "};\n");
     of.puts("int loop{0};\n");
+    of.puts("void converge_fail();\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        const string buckets = cvtToStr(v3Global.opt.convergeLimit() + 2);
+        of.puts("IData* _rf_deltas{nullptr};\n");
+        of.puts("std::vector<uint64_t> _eval_deltas = std::vector<uint64_t>(" + buckets + ");\n");
+        if (v3Global.opt.rtlflowCpu()) {
+            of.puts("std::vector<uint64_t> _lane_deltas = std::vector<uint64_t>(" + buckets
+                    + ");\n");
+        } else {
+            of.puts("unsigned long long* _rf_lane_deltas{nullptr};\n");
+        }
+        of.puts("std::vector<size_t> _unconverged;\n");
+    }
     of.puts("bool init{false};\n");
+    of.puts("std::vector<RfStream> _inputs;\n");
+    of.puts("std::vector<RfStream> _outputs;\n");
+    of.puts("RfBatch batch() const;\n");
+    of.puts("void restored(bool initialized);\n");
+    if (!v3Global.opt.rtlflowCpu()) {
+        of.puts("IData* _rf_any_change{nullptr};  // Past the IData signals\n");
+        of.puts("RfSegment* _rf_segments{nullptr};\n");
+        of.puts("IData* _rf_all{nullptr};\n");
+    }
+    if (v3Global.opt.rtlflowProf()) {
+        of.puts("RfProfiler _profiler{_executor.num_workers()};\n");
+        of.puts("vluint64_t _prof_mark{0};\n");
+        of.puts("vluint64_t _prof_eval{0};\n");
+        of.puts("uint32_t _prof_evals{0};\n");
+    }
+    if (v3Global.opt.rtlflowTrace()) {
+        of.puts("std::unique_ptr<RfLaneTracer> _tracer;\n");
+        if (!v3Global.opt.rtlflowCpu()) {
+            of.puts("RfTraceEntry* _trace_entries{nullptr};\n");
+            of.puts("size_t* _trace_lanes{nullptr};\n");
+            of.puts("QData* _trace_buffer{nullptr};\n");
+        }
+    }
 
     of.putsPrivate(false);
     of.puts("CData* _csignals{nullptr};\n");
     of.puts("SData* _ssignals{nullptr};\n");
     of.puts("IData* _isignals{nullptr};\n");
     of.puts("QData* _qsignals{nullptr};\n");
+    if (v3Global.opt.rtlflowBitslice()) {
+        of.puts("// Bit planes, bit k of word w holds stimulus 64 * w + k, and the\n");
+        of.puts("// active (not done, changed) stimuli of the current iteration; both\n");
+        of.puts("// are the tail of _qsignals, where the generated code finds them\n");
+        of.puts("QData* _bsignals{nullptr};\n");
+        of.puts("QData* _bactive{nullptr};\n");
+    }
     of.puts("IData* change{nullptr};\n");
-    of.puts("bool*  done{nullptr};\n");
+    of.puts("bool*  done{nullptr};  // Past the CData signals\n");
     // of.puts("IData* done{nullptr};\n");
     of.puts("RTLflow(size_t gpu_threads = 1);\n");
     of.puts("~RTLflow();\n");
     of.puts("void initialize(" + topClassName + "__Syms*);\n");
     of.puts("void run();\n");
+    of.puts("// True when $finish, $stop or the user has set done for every stimulus\n");
+    of.puts("bool all_done();\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("// --rtlflow-deltas: histograms of the delta iterations, entry d counts\n");
+        of.puts("// the evaluations of the batch, or the running stimuli of an evaluation,\n");
+        of.puts("// that took d iterations, the last entry more than --converge-limit\n");
+        of.puts("std::vector<uint64_t> eval_deltas() const;\n");
+        of.puts("std::vector<uint64_t> lane_deltas() const;\n");
+        of.puts("// Stimuli retired for not converging, in order\n");
+        of.puts("const std::vector<size_t>& unconverged() const { return _unconverged; }\n");
+    }
     of.puts("CData* get(CDataLoc cdl, size_t idx);\n");
     of.puts("SData* get(SDataLoc sdl, size_t idx);\n");
     of.puts("QData* get(QDataLoc qdl, size_t idx);\n");
     of.puts("IData* get(IDataLoc idl, size_t idx);\n");
+    static const std::vector<string> rfPoolTypes{"CData", "SData", "QData", "IData"};
+    of.puts("// Column-oriented I/O, one column holds a port for every stimulus\n");
+    for (const string& type : rfPoolTypes) {
+        of.puts("void write(" + type + "Loc loc, const " + type + "* column);\n");
+        of.puts("void read(" + type + "Loc loc, " + type + "* column) const;\n");
+    }
+    of.puts("// Streaming: cycle c is the column at columns + c * column size;\n");
+    of.puts("// load(c) copies the inputs into the batch, store(c) the outputs out\n");
+    for (const string& type : rfPoolTypes) {
+        of.puts("void input(" + type + "Loc loc, const " + type + "* columns);\n");
+        of.puts("void output(" + type + "Loc loc, " + type + "* columns);\n");
+    }
+    of.puts("void load(size_t cycle);\n");
+    of.puts("void store(size_t cycle);\n");
+    of.puts("// Column files: replay streams the input ports from reader, record\n");
+    of.puts("// declares the output ports in writer and streams them into it\n");
+    of.puts("void replay(const RfColumnReader& reader);\n");
+    of.puts("void record(RfColumnWriter& writer);\n");
+    of.puts("// Checkpoints of the whole batch: restore(path) restores every\n");
+    of.puts("// stimulus, restore(path, lanes) the given ones from the same lanes\n");
+    of.puts("// of the checkpoint, broadcast(path, from) sets every stimulus to\n");
+    of.puts("// saved stimulus from, from a checkpoint of any number of stimuli\n");
+    of.puts("void save(const std::string& path) const;\n");
+    of.puts("void restore(const std::string& path);\n");
+    of.puts("void restore(const std::string& path, const std::vector<size_t>& lanes);\n");
+    of.puts("void broadcast(const std::string& path, size_t from);\n");
+    of.puts("// Copy the state of stimulus from into stimuli [begin, end)\n");
+    of.puts("void fork(size_t from, size_t begin, size_t end);\n");
+    if (v3Global.opt.rtlflowProf()) {
+        of.puts("// --rtlflow-prof: write prefix.json (Chrome trace) and prefix.txt (summary)\n");
+        of.puts("bool profile(const std::string& prefix) const;\n");
+        of.puts("// --rtlflow-prof: discard the records so far\n");
+        of.puts("void profile_clear() { _profiler.clear(); }\n");
+    }
+    if (v3Global.opt.rtlflowDisplay()) {
+        of.puts("// --rtlflow-display: hand the $display/$write text of each stimulus,\n");
+        of.puts("// in order, to sink and empty the buffers, call between runs; returns\n");
+        of.puts("// the records drained, by default printed with a [stimulus] prefix\n");
+        of.puts("size_t display_drain(const std::function<void(size_t, const std::string&)>& "
+                "sink);\n");
+        of.puts("// Time recorded with the $display/$write of the following runs,\n");
+        of.puts("// the $time and %t of their text when drained\n");
+        of.puts("void display_time(vluint64_t time);\n");
+        of.puts("size_t display_drain();\n");
+    }
+    of.puts("// Retire the stimuli that made no progress lately, see rf_retire.h;\n");
+    of.puts("// call between runs, returns the lanes retired\n");
+    of.puts("std::vector<size_t> retire(RfRetirer& retirer);\n");
+    if (v3Global.opt.coverage()) {
+        of.puts("// --coverage: add the coverage of the batch, or of stimulus lane, to\n");
+        of.puts("// counts, the model's __Vcoverage bins registered with VerilatedCovContext\n");
+        of.puts("void coverage_reduce(uint32_t* counts) const;\n");
+        of.puts("void coverage_lane(size_t lane, uint32_t* counts) const;\n");
+        of.puts("void coverage_zero();\n");
+    }
+    if (v3Global.opt.rtlflowTrace()) {
+        of.puts("// --rtlflow-trace: trace_open writes prefix_<lane>suffix for each of\n");
+        of.puts("// lanes (VCD, or FST for suffix .fst), trace_dump after each run()\n");
+        of.puts("// writes their changed signals at time\n");
+        of.puts("void trace_open(const std::vector<size_t>& lanes, const std::string& prefix, "
+                "const std::string& suffix = \".vcd\");\n");
+        of.puts("void trace_dump(vluint64_t time);\n");
+        of.puts("void trace_close();\n");
+    }
     of.puts("};\n\n");
 
     of.puts("} // end of namespace RF ==================================== \n");
     of.puts("#endif  //\n");
 }
 void V3EmitC::emitRTLflowImp() {
+    if (v3Global.opt.rtlflowCpu()) {
+        emitRTLflowCpuImp();
+        return;
+    }
     string fileDir = v3Global.opt.makeDir() + "/";
     string topClassName = v3Global.opt.prefix();
     string filename = fileDir + "rtlflow.cu";
@@ -5320,6 +6795,8 @@ void V3EmitC::emitRTLflowImp() {
     of.puts("\n#include <cuda/algorithm/reduce.hpp>\n");
     of.puts("\n#include \"rtlflow.h\"\n\n");
     of.puts("\n#include \"" + topClassName + ".h\"\n\n");
+    // rfDisplayFormat() calls VL_SFORMATF_NX
+    if (v3Global.opt.rtlflowDisplay()) of.puts("#include \"rf_verilated_heavy.h\"\n\n");
     of.puts("#include <assert.h>\n\n");
     of.puts("// begin of namespace RF =====================================\n");
     of.puts("namespace RF {\n");
@@ -5331,6 +6808,35 @@ void V3EmitC::emitRTLflowImp() {
     of.puts("}\n");
     of.puts("return result;\n");
     of.puts("}\n\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("__global__ void _rf_count_deltas(const IData* change, IData* deltas, "
+                "size_t n) {\n");
+        of.puts("size_t k = blockDim.x * blockIdx.x + threadIdx.x;\n");
+        of.puts("if(k < n) deltas[k] += change[k] != 0;\n");
+        of.puts("}\n\n");
+        of.puts("__global__ void _rf_delta_hist(IData* deltas, const bool* done, "
+                "unsigned long long* hist, size_t n, IData last) {\n");
+        of.puts("size_t k = blockDim.x * blockIdx.x + threadIdx.x;\n");
+        of.puts("if(k >= n) return;\n");
+        of.puts("if(!done[k]) atomicAdd(&hist[min(deltas[k], last)], 1ULL);\n");
+        of.puts("deltas[k] = 0;\n");
+        of.puts("}\n\n");
+    }
+    of.puts("// Clears *all unless every stimulus is done\n");
+    of.puts("__global__ void _rf_all_done(const bool* done, size_t n, IData* all) {\n");
+    of.puts("size_t k = blockDim.x * blockIdx.x + threadIdx.x;\n");
+    of.puts("if(k < n && !done[k]) *all = 0;\n");
+    of.puts("}\n\n");
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("// Partitions the stimuli, active ones first, others from the back\n");
+        of.puts("__global__ void _rf_compact(const IData* change, const bool* done, IData* lanes, "
+                "IData* counts, size_t n) {\n");
+        of.puts("size_t k = blockDim.x * blockIdx.x + threadIdx.x;\n");
+        of.puts("if(k >= n) return;\n");
+        of.puts("if(!done[k] && change[k]) lanes[atomicAdd(&counts[0], 1)] = k;\n");
+        of.puts("else lanes[n - 1 - atomicAdd(&counts[1], 1)] = k;\n");
+        of.puts("}\n\n");
+    }
     of.puts("__global__ void _eval_settle(" + topClassName
             + "__Syms* __restrict vlSymsp, CData* _csignals, SData* _ssignals, IData* _isignals, "
               "QData* _qsignals);\n\n");
@@ -5348,34 +6854,79 @@ void V3EmitC::emitRTLflowImp() {
     of.puts("IData* RTLflow::get(IDataLoc idl, size_t idx) {\n");
     of.puts("return _isignals + idx * idl.size + idl.memloc;\n");
     of.puts("}\n");
+    emitRTLflowColumnIo(of);
+    emitRTLflowCheckpoint(of);
+    if (v3Global.opt.rtlflowProf()) emitRTLflowProfile(of);
+    if (v3Global.opt.rtlflowTrace()) emitRTLflowTrace(of);
+    if (v3Global.opt.coverage()) emitRTLflowCoverage(of);
+    emitRTLflowRetire(of);
+    if (v3Global.opt.rtlflowDisplay()) emitRTLflowDisplay(of);
     of.puts("RTLflow::RTLflow(size_t gpu_threads):gpu_threads{gpu_threads} {\n");
-    of.puts("checkCuda(cudaMallocManaged(&_csignals, gpu_threads * cuda_cmem_size * "
+    const string quadState = rfQuadStateWords();
+    of.puts("checkCuda(cudaMallocManaged(&_csignals, gpu_threads * (cuda_cmem_size + 1) * "
             "sizeof(CData)));\n");
     of.puts("checkCuda(cudaMallocManaged(&_ssignals, gpu_threads * cuda_smem_size * "
             "sizeof(SData)));\n");
-    of.puts("checkCuda(cudaMallocManaged(&_qsignals, gpu_threads * cuda_qmem_size * "
-            "sizeof(QData)));\n");
-    of.puts("checkCuda(cudaMallocManaged(&_isignals, gpu_threads * cuda_imem_size * "
-            "sizeof(IData)));\n");
+    of.puts("checkCuda(cudaMallocManaged(&_qsignals, (gpu_threads * cuda_qmem_size"
+            + (quadState.empty() ? "" : " + " + quadState) + ") * sizeof(QData)));\n");
+    of.puts("checkCuda(cudaMallocManaged(&_isignals, (gpu_threads * cuda_imem_size + "
+            + rfIntStateWords() + ") * sizeof(IData)));\n");
     of.puts("checkCuda(cudaMallocManaged(&change, gpu_threads * sizeof(IData)));\n");
-    of.puts("checkCuda(cudaMallocManaged(&done, gpu_threads * sizeof(bool)));\n");
     // of.puts("checkCuda(cudaMallocManaged(&done, gpu_threads * sizeof(IData)));\n");
+    of.puts("done = rfDone(_csignals);\n");
+    of.puts("_rf_any_change = rfAnyChange(_isignals);\n");
     of.puts("checkCuda(cudaMemset(change, 1, gpu_threads * sizeof(IData)));\n");
     of.puts("checkCuda(cudaMemset(done, 0, gpu_threads * sizeof(bool)));\n");
+    of.puts("checkCuda(cudaMemset(_rf_any_change, 0, (" + rfIntStateWords()
+            + ") * sizeof(IData)));\n");
     // of.puts("checkCuda(cudaMemset(done, 0, gpu_threads * sizeof(IData)));\n");
+    of.puts("checkCuda(cudaMallocManaged(&_rf_all, sizeof(IData)));\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("checkCuda(cudaMallocManaged(&_rf_deltas, gpu_threads * sizeof(IData)));\n");
+        of.puts("checkCuda(cudaMemset(_rf_deltas, 0, gpu_threads * sizeof(IData)));\n");
+        const string buckets = cvtToStr(v3Global.opt.convergeLimit() + 2);
+        of.puts("checkCuda(cudaMallocManaged(&_rf_lane_deltas, " + buckets
+                + " * sizeof(unsigned long long)));\n");
+        of.puts("checkCuda(cudaMemset(_rf_lane_deltas, 0, " + buckets
+                + " * sizeof(unsigned long long)));\n");
+    }
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("_rf_lanes = rfActive(_isignals);\n");
+        of.puts("checkCuda(cudaMallocManaged(&_rf_next, gpu_threads * sizeof(IData)));\n");
+        of.puts("checkCuda(cudaMallocManaged(&_rf_counts, 2 * sizeof(IData)));\n");
+        of.puts("for(size_t i = 0; i < gpu_threads; ++i) _rf_lanes[i] = i;\n");
+    }
+    if (v3Global.opt.coverage()) of.puts("_covsignals = rfCoverage(_isignals);\n");
+    if (v3Global.opt.rtlflowDisplay()) {
+        of.puts("_display = rfDisplay(_qsignals, _isignals);\n");
+        of.puts("*_display.time = 0;\n");
+    }
     of.puts("}\n");
     of.puts("RTLflow::~RTLflow() {\n");
+    if (v3Global.opt.rtlflowTrace()) of.puts("trace_close();\n");
     of.puts("checkCuda(cudaFree(_csignals));\n");
     of.puts("checkCuda(cudaFree(_ssignals));\n");
     of.puts("checkCuda(cudaFree(_qsignals));\n");
     of.puts("checkCuda(cudaFree(_isignals));\n");
     of.puts("checkCuda(cudaFree(change));\n");
-    of.puts("checkCuda(cudaFree(done));\n");
+    of.puts("checkCuda(cudaFree(_rf_segments));\n");
+    of.puts("checkCuda(cudaFree(_rf_all));\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("checkCuda(cudaFree(_rf_deltas));\n");
+        of.puts("checkCuda(cudaFree(_rf_lane_deltas));\n");
+    }
     // of.puts("checkCuda(cudaFree(done));\n");
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("checkCuda(cudaFree(_rf_next));\n");
+        of.puts("checkCuda(cudaFree(_rf_counts));\n");
+    }
     of.puts("}\n");
     of.puts("void RTLflow::run() { _executor.run(_taskflow).wait(); }\n");
+    emitRTLflowAllDone(of);
+    emitRTLflowConverge(of);
 
     of.puts("void RTLflow::initialize(" + topClassName + "__Syms* VlSymsp) {\n");
+    if (v3Global.opt.rtlflowDisplay()) of.puts("_name = VlSymsp->name();\n");
     // of.puts(topClassName + "__Syms* __restrict vlSymsp = _mdoule->__VlSymsp;\n");
 
     AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
@@ -5386,16 +6937,33 @@ void V3EmitC::emitRTLflowImp() {
     // I need to caculate graph size myself
     of.puts("size_t num_threads = (gpu_threads < 128) ? gpu_threads : 128;\n");
     of.puts("size_t num_blocks = (num_threads < 128) ? 1 : gpu_threads / num_threads;\n");
-    of.puts(
-        "auto change_cut = _cudaflow.kernel(dim3(num_blocks, 1, 1), dim3(num_threads, 1, 1), 0, "
-        "_change_request, VlSymsp, _csignals, _ssignals, _isignals, _qsignals, change);\n");
-    of.puts(
-        "auto last_assign_cut = _cudaflow.kernel(dim3(num_blocks, 1, 1), dim3(num_threads, 1, 1), "
-        "0, _last_assign, _csignals, _ssignals, _isignals, _qsignals);\n");
-    of.puts("auto reduce_cut = _cudaflow.reduce(change, change + gpu_threads, change, [] "
-            "__device__ (IData a, IData b){ return a | b; });\n");
-    of.puts("last_assign_cut.precede(change_cut);\n\n");
-    of.puts("change_cut.precede(reduce_cut);\n\n");
+    // The stage the sink mtasks precede, if any
+    string tail;
+    if (!rfLastAssignEmpty()) {
+        of.puts("auto last_assign_cut = _cudaflow.kernel(dim3(num_blocks, 1, 1), "
+                "dim3(num_threads, 1, 1), 0, _last_assign, _csignals, _ssignals, _isignals, "
+                "_qsignals);\n");
+        tail = "last_assign_cut";
+    }
+    if (v3Global.rtlflowChangeDet()) {
+        // The changed stimuli set _rf_any_change, the host reads that one word
+        of.puts("auto clear_cut = _cudaflow.zero(_rf_any_change, 1);\n");
+        of.puts("auto change_cut = _cudaflow.kernel(dim3(num_blocks, 1, 1), dim3(num_threads, 1, "
+                "1), 0, _change_request, VlSymsp, _csignals, _ssignals, _isignals, _qsignals, "
+                "change);\n");
+        if (tail.empty()) {
+            tail = "change_cut";
+        } else {
+            of.puts(tail + ".precede(change_cut);\n");
+        }
+        of.puts("clear_cut.precede(change_cut);\n\n");
+        if (v3Global.opt.rtlflowDeltas()) {
+            of.puts("auto deltas_cut = _cudaflow.kernel(dim3((gpu_threads + num_threads - 1) / "
+                    "num_threads, 1, 1), dim3(num_threads, 1, 1), 0, _rf_count_deltas, change, "
+                    "_rf_deltas, gpu_threads);\n");
+            of.puts("change_cut.precede(deltas_cut);\n\n");
+        }
+    }
 
     // create tasks
     for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
@@ -5418,12 +6986,38 @@ void V3EmitC::emitRTLflowImp() {
                     + "_cut);\n");
         }
 
-        if (mtp->outBeginp() == nullptr) {
-            of.puts("id_" + cvtToStr(mtp->id()) + "_cut.precede(last_assign_cut);\n");
+        if (mtp->outBeginp() == nullptr && !tail.empty()) {
+            of.puts("id_" + cvtToStr(mtp->id()) + "_cut.precede(" + tail + ");\n");
         }
     }
 
+    if (v3Global.opt.rtlflowActiveSet()) {
+        // Relaunch the mtask kernels over the active stimuli only
+        of.puts("auto resize_mtasks = [=](size_t blocks){\n");
+        for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
+             vxp = vxp->verticesNextp()) {
+            const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+            of.puts("_cudaflow.kernel(id_" + cvtToStr(mtp->id())
+                    + "_cut, dim3(blocks, 1, 1), dim3(num_threads, 1, 1), 0, __Vmtask__"
+                    + cvtToStr(mtp->id())
+                    + ", VlSymsp, _csignals, _ssignals, _isignals, _qsignals, change, done);\n");
+        }
+        of.puts("};\n");
+        of.puts("auto compact_active = [=](){\n");
+        of.puts("checkCuda(cudaMemset(_rf_counts, 0, 2 * sizeof(IData)));\n");
+        of.puts("_rf_compact<<<dim3((gpu_threads + num_threads - 1) / num_threads, 1, 1), "
+                "dim3(num_threads, 1, 1), 0>>>(change, done, _rf_next, _rf_counts, "
+                "gpu_threads);\n");
+        of.puts("checkCuda(cudaMemcpy(_rf_lanes, _rf_next, gpu_threads * sizeof(IData), "
+                "cudaMemcpyDeviceToDevice));\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+        of.puts("resize_mtasks(std::max<size_t>(1, (_rf_counts[0] + num_threads - 1) / "
+                "num_threads));\n");
+        of.puts("};\n\n");
+    }
+
     of.puts("auto start_t = _taskflow.emplace([=](){\n");
+    if (v3Global.opt.rtlflowProf()) of.puts("_prof_mark = _prof_eval = RfProfiler::ticks();\n");
     of.puts("if(VL_UNLIKELY(!init)) {\n");
     of.puts(v3Global.opt.prefix()
             + "::_eval_initial(VlSymsp, _csignals, _ssignals, _isignals, _qsignals);\n");
@@ -5443,6 +7037,10 @@ void V3EmitC::emitRTLflowImp() {
             "device));\n");
     of.puts("checkCuda(cudaMemPrefetchAsync(change, gpu_threads * sizeof(IData), device));\n");
     of.puts("checkCuda(cudaMemPrefetchAsync(done, gpu_threads * sizeof(bool), device));\n");
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("checkCuda(cudaMemPrefetchAsync(_rf_lanes, gpu_threads * sizeof(IData), "
+                "device));\n");
+    }
     of.puts("init = true;\n");
     of.puts("return 0;\n");
     of.puts("}\n");
@@ -5451,18 +7049,6 @@ void V3EmitC::emitRTLflowImp() {
     of.puts("}\n");
     of.puts("});\n\n");
 
-    of.puts("auto init_detect_t = _taskflow.emplace([=](){\n");
-    of.puts("if(++loop > 100) {\n");
-    of.puts("_change_request<<<dim3(num_blocks, 1, 1), dim3(num_threads, 1, 1), 0>>>(VlSymsp, "
-            "_csignals, _ssignals, _isignals, _qsignals, change);\n");
-    of.puts("checkCuda(cudaDeviceSynchronize());\n");
-    of.puts("VL_FATAL_MT(\"add.v\", 2, \"\",\n");
-    of.puts("\"Verilated model didn't converge\"\n");
-    of.puts("\"- See https://verilator.org/warn/DIDNOTCONVERGE\");\n");
-    of.puts("}\n");
-    of.puts("return (bool)change[0];\n");
-    of.puts("});\n");
-
     of.puts("auto init_sim_t = _taskflow.emplace([=](){\n");
     of.puts(
         "_eval_settle<<<dim3(num_blocks, 1, 1), dim3(num_threads, 1, 1), 0>>>(VlSymsp, _csignals, "
@@ -5474,26 +7060,273 @@ void V3EmitC::emitRTLflowImp() {
     of.puts("auto sim_t = _taskflow.emplace([=](){\n");
     of.puts("_cudaflow.offload();\n");
     of.puts("});\n");
-    of.puts("auto end_t = _taskflow.emplace([=](){\n");
+    emitRTLflowEndBegin(of);
+    if (v3Global.opt.rtlflowProf()) {
+        of.puts("_profiler.record(_executor.this_worker_id(), RF_PROF_EVAL, _prof_evals++, 0, "
+                "_prof_eval, RfProfiler::ticks());\n");
+    }
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("++_eval_deltas[std::min(loop, " + cvtToStr(v3Global.opt.convergeLimit() + 1)
+                + ")];\n");
+        of.puts("_rf_delta_hist<<<dim3((gpu_threads + 127) / 128, 1, 1), dim3(128, 1, 1), 0>>>("
+                "_rf_deltas, done, _rf_lane_deltas, gpu_threads, "
+                + cvtToStr(v3Global.opt.convergeLimit() + 1) + ");\n");
+        of.puts("checkCuda(cudaDeviceSynchronize());\n");
+    }
     of.puts("loop = 0;\n");
     of.puts("checkCuda(cudaMemset(change, 1, sizeof(IData) * gpu_threads));\n");
-    of.puts("});\n\n");
-    of.puts("auto detect_t = _taskflow.emplace([=](){\n");
-    of.puts("if(++loop > 100) {\n");
-    of.puts("_change_request<<<dim3(num_blocks, 1, 1), dim3(num_threads, 1, 1), 0>>>(VlSymsp, "
-            "_csignals, _ssignals, _isignals, _qsignals, change);\n");
-    of.puts("checkCuda(cudaDeviceSynchronize());\n");
-    of.puts("VL_FATAL_MT(\"add.v\", 2, \"\",\n");
-    of.puts("\"Verilated model didn't converge\"\n");
-    of.puts("\"- See https://verilator.org/warn/DIDNOTCONVERGE\");\n");
+    if (v3Global.opt.rtlflowActiveSet()) of.puts("compact_active();\n");
+    emitRTLflowEndFinish(of);
+
+    of.puts("}\n");
+    of.puts("} // end of namespace RF ==================================== \n");
+}
+
+// RTLflow: --rtlflow-backend cpu
+// The mtask graph is replicated once per chunk of stimuli so that the chunks
+// flow through the graph independently; only the change reduction joins them.
+void V3EmitC::emitRTLflowCpuImp() {
+    string fileDir = v3Global.opt.makeDir() + "/";
+    string topClassName = v3Global.opt.prefix();
+    string filename = fileDir + "rtlflow.cpp";
+
+    AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), filename);
+    cfilep->slow(false);
+    cfilep->source(true);
+    v3Global.rootp()->addFilesp(cfilep);
+
+    V3OutCFile of(filename);
+    of.puts("\n#include <taskflow.hpp>\n");
+    of.puts("\n#include \"rtlflow.h\"\n\n");
+    of.puts("\n#include \"" + topClassName + ".h\"\n\n");
+    // rfDisplayFormat() calls VL_SFORMATF_NX
+    if (v3Global.opt.rtlflowDisplay()) of.puts("#include \"rf_verilated_heavy.h\"\n\n");
+    of.puts("#include <algorithm>\n");
+    of.puts("#include <cstdlib>\n");
+    of.puts("#include <cstring>\n\n");
+    of.puts("// begin of namespace RF =====================================\n");
+    of.puts("namespace RF {\n");
+    of.puts("void _eval_settle(" + topClassName
+            + "__Syms* __restrict vlSymsp, CData* _csignals, SData* _ssignals, IData* _isignals, "
+              "QData* _qsignals, size_t _rf_begin, size_t _rf_end);\n\n");
+
+    of.puts("// idx: index of testbenches\n");
+    of.puts("CData* RTLflow::get(CDataLoc cdl, size_t idx) {\n");
+    of.puts("return _csignals + idx * cdl.size + cdl.memloc;\n");
+    of.puts("}\n");
+    of.puts("SData* RTLflow::get(SDataLoc sdl, size_t idx) {\n");
+    of.puts("return _ssignals + idx * sdl.size + sdl.memloc;\n");
+    of.puts("}\n");
+    of.puts("QData* RTLflow::get(QDataLoc qdl, size_t idx) {\n");
+    of.puts("return _qsignals + idx * qdl.size + qdl.memloc;\n");
+    of.puts("}\n");
+    of.puts("IData* RTLflow::get(IDataLoc idl, size_t idx) {\n");
+    of.puts("return _isignals + idx * idl.size + idl.memloc;\n");
+    of.puts("}\n");
+    emitRTLflowColumnIo(of);
+    emitRTLflowCheckpoint(of);
+    if (v3Global.opt.rtlflowProf()) emitRTLflowProfile(of);
+    if (v3Global.opt.rtlflowTrace()) emitRTLflowTrace(of);
+    if (v3Global.opt.coverage()) emitRTLflowCoverage(of);
+    emitRTLflowRetire(of);
+    if (v3Global.opt.rtlflowDisplay()) emitRTLflowDisplay(of);
+    of.puts("RTLflow::RTLflow(size_t gpu_threads):gpu_threads{gpu_threads} {\n");
+    const string quadState = rfQuadStateWords();
+    of.puts("_csignals = (CData*)std::calloc(gpu_threads * (cuda_cmem_size + 1), "
+            "sizeof(CData));\n");
+    of.puts("_ssignals = (SData*)std::calloc(gpu_threads * cuda_smem_size, sizeof(SData));\n");
+    of.puts("_qsignals = (QData*)std::calloc(gpu_threads * cuda_qmem_size"
+            + (quadState.empty() ? "" : " + " + quadState) + ", sizeof(QData));\n");
+    if (v3Global.opt.rtlflowBitslice()) {
+        of.puts("_bsignals = _qsignals + gpu_threads * cuda_qmem_size;\n");
+        of.puts("_bactive = _bsignals + (gpu_threads + 63) / 64 * cuda_bmem_size;\n");
+    }
+    of.puts("_isignals = (IData*)std::calloc(gpu_threads * cuda_imem_size + " + rfIntStateWords()
+            + ", sizeof(IData));\n");
+    of.puts("change = (IData*)std::calloc(gpu_threads, sizeof(IData));\n");
+    of.puts("done = rfDone(_csignals);\n");
+    of.puts("std::fill_n(change, gpu_threads, 1);\n");
+    if (v3Global.opt.rtlflowDeltas()) {
+        of.puts("_rf_deltas = (IData*)std::calloc(gpu_threads, sizeof(IData));\n");
+    }
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("_rf_lanes = (IData*)std::calloc(gpu_threads, sizeof(IData));\n");
+    }
+    if (v3Global.opt.coverage()) of.puts("_covsignals = rfCoverage(_isignals);\n");
+    if (v3Global.opt.rtlflowDisplay()) of.puts("_display = rfDisplay(_qsignals, _isignals);\n");
+    of.puts("}\n");
+    of.puts("RTLflow::~RTLflow() {\n");
+    if (v3Global.opt.rtlflowTrace()) of.puts("trace_close();\n");
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("std::free(_rf_lanes);\n");
+        of.puts("std::free(_rf_num_active);\n");
+    }
+    of.puts("std::free(_rf_chunk_change);\n");
+    if (v3Global.opt.rtlflowDeltas()) of.puts("std::free(_rf_deltas);\n");
+    of.puts("std::free(_csignals);\n");
+    of.puts("std::free(_ssignals);\n");
+    of.puts("std::free(_qsignals);\n");
+    of.puts("std::free(_isignals);\n");
+    of.puts("std::free(change);\n");
     of.puts("}\n");
-    of.puts("return (bool)change[0];\n");
+    of.puts("void RTLflow::run() { _executor.run(_taskflow).wait(); }\n");
+    emitRTLflowAllDone(of);
+    emitRTLflowConverge(of);
+
+    of.puts("void RTLflow::initialize(" + topClassName + "__Syms* VlSymsp) {\n");
+    if (v3Global.opt.rtlflowDisplay()) of.puts("_name = VlSymsp->name();\n");
+
+    AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
+    UASSERT_OBJ(execGraphp, v3Global.rootp(), "Root should have an execGraphp");
+    const V3Graph* depGraphp = execGraphp->depGraphp();
+
+    of.puts("size_t num_chunks = std::max<size_t>(1, std::min(gpu_threads, "
+            "_executor.num_workers()));\n");
+    of.puts("size_t chunk_size = (gpu_threads + num_chunks - 1) / num_chunks;\n");
+    if (v3Global.opt.rtlflowBitslice()) {
+        of.puts("// chunks own whole bit-plane words\n");
+        of.puts("chunk_size = (chunk_size + 63) / 64 * 64;\n");
+    }
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("_rf_num_active = (size_t*)std::calloc(num_chunks, sizeof(size_t));\n");
+    }
+    const bool changeDet = v3Global.rtlflowChangeDet();
+    if (changeDet) {
+        // Each chunk reduces its own stimuli, the host reads one flag per chunk
+        of.puts("_rf_chunk_change = (IData*)std::calloc(num_chunks, sizeof(IData));\n");
+        of.puts("auto reduce_t = _simflow.emplace([=](){\n");
+        of.puts("IData any_change = 0;\n");
+        of.puts("for(size_t c = 0; c < num_chunks && !any_change; ++c) "
+                "any_change = _rf_chunk_change[c];\n");
+        of.puts("_any_change = any_change;\n");
+        of.puts("}).name(\"reduce\");\n");
+    }
+    of.puts("auto init_sim_m = _initflow.composed_of(_simflow).name(\"sim\");\n\n");
+
+    of.puts("for(size_t c = 0; c < num_chunks; ++c) {\n");
+    of.puts("size_t b = c * chunk_size;\n");
+    of.puts("size_t e = std::min(b + chunk_size, gpu_threads);\n");
+    of.puts("auto settle_t = _initflow.emplace([=](){\n");
+    of.puts("_eval_settle(VlSymsp, _csignals, _ssignals, _isignals, _qsignals, b, e);\n");
     of.puts("});\n");
-    of.puts("start_t.precede(init_sim_t, sim_t);\n");
-    of.puts("init_sim_t.precede(init_detect_t);\n");
-    of.puts("init_detect_t.precede(end_t, init_sim_t);\n\n");
-    of.puts("sim_t.precede(detect_t);\n");
-    of.puts("detect_t.precede(end_t, sim_t);\n");
+    of.puts("settle_t.precede(init_sim_m);\n");
+    // The stage the sink mtasks precede, if any
+    string tail;
+    if (!rfLastAssignEmpty()) {
+        of.puts("auto last_assign_t = _simflow.emplace([=](){\n");
+        of.puts("_last_assign(_csignals, _ssignals, _isignals, _qsignals, b, e);\n");
+        of.puts("});\n");
+        tail = "last_assign_t";
+    }
+    if (changeDet) {
+        of.puts("auto change_t = _simflow.emplace([=](){\n");
+        of.puts("_change_request(VlSymsp, _csignals, _ssignals, _isignals, _qsignals, change, "
+                "b, e);\n");
+        of.puts("IData any_change = 0;\n");
+        of.puts("for(size_t i = b; i < e; ++i) {\n");
+        of.puts("any_change |= change[i];\n");
+        if (v3Global.opt.rtlflowDeltas()) of.puts("_rf_deltas[i] += change[i] != 0;\n");
+        of.puts("}\n");
+        of.puts("_rf_chunk_change[c] = any_change;\n");
+        of.puts("});\n");
+        if (tail.empty()) {
+            tail = "change_t";
+        } else {
+            of.puts(tail + ".precede(change_t);\n");
+        }
+        of.puts("change_t.precede(reduce_t);\n");
+    }
+    of.puts("\n");
+    if (v3Global.opt.rtlflowBitslice()) {
+        of.puts("auto active_t = _simflow.emplace([=](){\n");
+        of.puts("for(size_t w = b >> 6; w < ((e + 63) >> 6); ++w) {\n");
+        of.puts("QData active = 0;\n");
+        of.puts("for(size_t i = w << 6; i < std::min((w + 1) << 6, e); ++i) {\n");
+        of.puts("if(!done[i] && change[i]) active |= 1ULL << (i & 63);\n");
+        of.puts("}\n");
+        of.puts("_bactive[w] = active;\n");
+        of.puts("}\n");
+        of.puts("});\n");
+    }
+    if (v3Global.opt.rtlflowActiveSet()) {
+        of.puts("// Indices of the active stimuli of the chunk, at _rf_lanes + b\n");
+        of.puts("auto compact_t = _simflow.emplace([=](){\n");
+        of.puts("size_t n = 0;\n");
+        of.puts("for(size_t i = b; i < e; ++i) {\n");
+        of.puts("if(!done[i] && change[i]) _rf_lanes[b + n++] = i;\n");
+        of.puts("}\n");
+        of.puts("_rf_num_active[c] = n;\n");
+        of.puts("});\n");
+    }
+
+    // create tasks
+    for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+        of.puts("auto id_" + cvtToStr(mtp->id()) + "_t = _simflow.emplace([=](){\n");
+        if (v3Global.opt.rtlflowProf()) of.puts("vluint64_t _rf_start = RfProfiler::ticks();\n");
+        of.puts("__Vmtask__" + cvtToStr(mtp->id())
+                + "(VlSymsp, _csignals, _ssignals, _isignals, _qsignals, change, done, b, e"
+                + (v3Global.opt.rtlflowActiveSet() ? ", _rf_lanes + b, _rf_num_active[c]" : "")
+                + ");\n");
+        if (v3Global.opt.rtlflowProf()) {
+            of.puts("_profiler.record(_executor.this_worker_id(), RF_PROF_MTASK, "
+                    + cvtToStr(mtp->id()) + ", c, _rf_start, RfProfiler::ticks());\n");
+        }
+        of.puts("}).name(\"task_" + cvtToStr(mtp->id()) + "\");\n");
+    }
+
+    // dependencies
+    for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+        for (V3GraphEdge* edgep = mtp->outBeginp(); edgep; edgep = edgep->outNextp()) {
+            const ExecMTask* prevp = dynamic_cast<ExecMTask*>(edgep->top());
+            of.puts("id_" + cvtToStr(mtp->id()) + "_t.precede(id_" + cvtToStr(prevp->id())
+                    + "_t);\n");
+        }
+        if (v3Global.opt.rtlflowBitslice() && mtp->inBeginp() == nullptr) {
+            of.puts("active_t.precede(id_" + cvtToStr(mtp->id()) + "_t);\n");
+        }
+        if (v3Global.opt.rtlflowActiveSet() && mtp->inBeginp() == nullptr) {
+            of.puts("compact_t.precede(id_" + cvtToStr(mtp->id()) + "_t);\n");
+        }
+
+        if (mtp->outBeginp() == nullptr && !tail.empty()) {
+            of.puts("id_" + cvtToStr(mtp->id()) + "_t.precede(" + tail + ");\n");
+        }
+    }
+    of.puts("}\n\n");
+
+    of.puts("auto start_t = _taskflow.emplace([=](){\n");
+    if (v3Global.opt.rtlflowProf()) of.puts("_prof_mark = _prof_eval = RfProfiler::ticks();\n");
+    of.puts("if(VL_UNLIKELY(!init)) {\n");
+    of.puts(v3Global.opt.prefix()
+            + "::_eval_initial(VlSymsp, _csignals, _ssignals, _isignals, _qsignals);\n");
+    of.puts("init = true;\n");
+    of.puts("return 0;\n");
+    of.puts("}\n");
+    of.puts("else {\n");
+    of.puts("return 1;\n");
+    of.puts("}\n");
+    of.puts("});\n\n");
+
+    of.puts("auto init_sim_t = _taskflow.composed_of(_initflow);\n");
+    of.puts("auto sim_t = _taskflow.composed_of(_simflow);\n");
+    emitRTLflowEndBegin(of);
+    if (v3Global.opt.rtlflowProf()) {
+        of.puts("_profiler.record(_executor.this_worker_id(), RF_PROF_EVAL, _prof_evals++, 0, "
+                "_prof_eval, RfProfiler::ticks());\n");
+    }
+    if (v3Global.opt.rtlflowDeltas()) {
+        const string last = cvtToStr(v3Global.opt.convergeLimit() + 1);
+        of.puts("++_eval_deltas[std::min(loop, " + last + ")];\n");
+        of.puts("for(size_t i = 0; i < gpu_threads; ++i) {\n");
+        of.puts("if(!done[i]) ++_lane_deltas[std::min<IData>(_rf_deltas[i], " + last + ")];\n");
+        of.puts("_rf_deltas[i] = 0;\n");
+        of.puts("}\n");
+    }
+    of.puts("loop = 0;\n");
+    of.puts("std::fill_n(change, gpu_threads, 1);\n");
+    emitRTLflowEndFinish(of);
 
     of.puts("}\n");
     of.puts("} // end of namespace RF ==================================== \n");
@@ -5507,27 +7340,44 @@ void V3EmitC::emitc() {
     // size_t cuda_imem_size = std::get<2>(cuda_mem_sizes);
     // size_t cuda_qmem_size = std::get<3>(cuda_mem_sizes);
 
+    if (v3Global.opt.rtlflowBitslice()) {
+        rfBitSliceMarker bitSliceMarker;
+        bitSliceMarker.mark();
+    }
     cudaModSizeSetter modSetter;
     modSetter.setModSize();
     cudaMemLocSetter setter;
     setter.setMemLoc();
     cudaCheck cc;
     cc.check();
-    // Process each module in turn
+    if (v3Global.opt.rtlflowSimd()) {
+        rfSimdMarker simdMarker;
+        simdMarker.mark();
+    }
+    if (v3Global.opt.coverage()) {
+        s_rfCoverBins = rfCoverBinCounter().bins();
+        V3Stats::addStat("RTLflow, coverage bins", s_rfCoverBins);
+    }
+    if (v3Global.opt.rtlflowDisplay()) rfDisplayNumberer();
+    // Process each module in turn, the interface and slow files of each
+    // module as one job and its fast files as another
+    std::vector<std::unique_ptr<EmitCImp>> emitters;
+    std::vector<V3ThreadPool::Job> jobs;
     for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep;
          nodep = VN_CAST(nodep->nextp(), NodeModule)) {
         if (VN_IS(nodep, Class)) continue;  // Imped with ClassPackage
-        {
-            EmitCImp cint;
-
-            cint.mainInt(nodep);
-            cint.mainImp(nodep, true);
-        }
-        {
-            EmitCImp fast;
-            fast.mainImp(nodep, false);
-        }
+        EmitCImp* const cintp = new EmitCImp;
+        emitters.emplace_back(cintp);
+        jobs.emplace_back([cintp, nodep]() {
+            cintp->mainInt(nodep);
+            cintp->mainImp(nodep, true);
+        });
+        EmitCImp* const fastp = new EmitCImp;
+        emitters.emplace_back(fastp);
+        jobs.emplace_back([fastp, nodep]() { fastp->mainImp(nodep, false); });
     }
+    V3ThreadPool::run(jobs);
+    for (const auto& emitterp : emitters) emitterp->addCFiles();
     // RTLflow
     AstModule* topp = VN_CAST(v3Global.rootp()->topModulep(), Module);
     emitRTLflowInt(topp->cmem(), topp->smem(), topp->imem(), topp->qmem());
@@ -5537,14 +7387,11 @@ void V3EmitC::emitc() {
 void V3EmitC::emitcTrace() {
     UINFO(2, __FUNCTION__ << ": " << endl);
     if (v3Global.opt.trace()) {
-        {
-            EmitCTrace slow(true);
-            slow.main();
-        }
-        {
-            EmitCTrace fast(false);
-            fast.main();
-        }
+        EmitCTrace slow(true);
+        EmitCTrace fast(false);
+        V3ThreadPool::run({[&slow]() { slow.main(); }, [&fast]() { fast.main(); }});
+        slow.addCFiles();
+        fast.addCFiles();
     }
 }
 
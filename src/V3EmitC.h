@@ -23,6 +23,8 @@
 #include "V3Error.h"
 #include "V3Ast.h"
 
+class V3OutCFile;
+
 //============================================================================
 
 class V3EmitC final {
@@ -43,7 +45,23 @@ public:
     // RTLflow
     static void emitRTLflowInt(size_t cuda_cmem_size, size_t cuda_smem_size, size_t cuda_imem_size,
                                size_t cuda_qmem_size);
+    static void emitRTLflowState(V3OutCFile& of);
     static void emitRTLflowImp();
+    static void emitRTLflowCpuImp();
+    static void emitRTLflowColumnIo(V3OutCFile& of);
+    static void emitRTLflowCheckpoint(V3OutCFile& of);
+    static void emitRTLflowProfile(V3OutCFile& of);
+    static void emitRTLflowProfileIter(V3OutCFile& of);
+    static void emitRTLflowTrace(V3OutCFile& of);
+    static void emitRTLflowCoverage(V3OutCFile& of);
+    static void emitRTLflowAllDone(V3OutCFile& of);
+    static void emitRTLflowConverge(V3OutCFile& of);
+    static void emitRTLflowEndBegin(V3OutCFile& of);
+    static void emitRTLflowEndFinish(V3OutCFile& of);
+    static void emitRTLflowDetect(V3OutCFile& of);
+    static void emitRTLflowConvergeCheck(V3OutCFile& of);
+    static void emitRTLflowRetire(V3OutCFile& of);
+    static void emitRTLflowDisplay(V3OutCFile& of);
 
     // static std::tuple<size_t, size_t, size_t, size_t> cuda_mem();
 };
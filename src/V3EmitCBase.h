@@ -77,6 +77,61 @@ public:
     static string topClassName() {  // Return name of top wrapper module
         return v3Global.opt.prefix();
     }
+    // RTLflow
+    static string rfTid() {  // Index of the stimulus evaluated by the current thread
+        if (v3Global.opt.rtlflowCpu()) return "i";
+        // --rtlflow-active-set: threads are mapped through the active lane permutation
+        if (v3Global.opt.rtlflowActiveSet()) {
+            return "rfActive(_isignals)[blockDim.x * blockIdx.x + threadIdx.x]";
+        }
+        return "(blockDim.x * blockIdx.x + threadIdx.x)";
+    }
+    static string rfCudaScope(const AstCFunc* nodep) {  // Qualifier, none on the CPU backend
+        return v3Global.opt.rtlflowCpu() ? "" : nodep->cudaScope();
+    }
+    static string rfGlobal() { return v3Global.opt.rtlflowCpu() ? "" : "__global__ "; }
+    static string rfSourceExt() {  // Suffix of generated sources, host C++ on the CPU backend
+        return v3Global.opt.rtlflowCpu() ? ".cpp" : ".cu";
+    }
+    // --rtlflow-bitslice: the bit planes, then the _bactive word of each 64
+    // stimuli, follow the QData signals at the end of the _qsignals pool
+    static string rfBitPlanes() {
+        const AstModule* topp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+        return "(_qsignals + THREADS * " + cvtToStr(topp->qmem()) + ")";
+    }
+    static string rfBitActive() {
+        const AstModule* topp = VN_CAST(v3Global.rootp()->topModulep(), Module);
+        return "(" + rfBitPlanes() + " + BWORDS * " + cvtToStr(topp->bmem()) + ")";
+    }
+    static string rfMTaskArgs() {  // Parameter list of an mtask function
+        string args = "void* symtab, CData* _csignals, SData* _ssignals, IData* _isignals, "
+                      "QData* _qsignals, IData* change, bool* done";
+        if (v3Global.opt.rtlflowCpu()) args += ", size_t _rf_begin, size_t _rf_end";
+        if (v3Global.opt.rtlflowCpu() && v3Global.opt.rtlflowActiveSet()) {
+            args += ", const IData* _rf_active, size_t _rf_num_active";
+        }
+        return args;
+    }
+    static bool rfCpuKernel(const AstCFunc* nodep) {  // Host kernel over a chunk of stimuli
+        return v3Global.opt.rtlflowCpu() && nodep->device() && nodep->cudaScope() == "__global__";
+    }
+    static string rfBackendArgs(const AstCFunc* nodep) {
+        // On the CPU backend, kernels loop over a [begin, end) chunk of stimuli and
+        // device functions are handed the stimulus index by their caller
+        if (!v3Global.opt.rtlflowCpu() || !nodep->device()) return "";
+        if (rfCpuKernel(nodep) || nodep->bitSlice()) return "size_t _rf_begin, size_t _rf_end";
+        if (nodep->simdLanes()) {
+            return "size_t _rf_begin, size_t _rf_end, const IData* __restrict change, "
+                   "const bool* __restrict done";
+        }
+        return "size_t i";
+    }
+    static string rfBackendCallArgs(const AstCFunc* nodep) {  // Arguments for rfBackendArgs
+        if (!v3Global.opt.rtlflowCpu() || !nodep->device()) return "";
+        if (rfCpuKernel(nodep) || nodep->bitSlice()) return "_rf_begin, _rf_end";
+        if (nodep->simdLanes()) return "_rf_begin, _rf_end, change, done";
+        return "i";
+    }
     static AstCFile* newCFile(const string& filename, bool slow, bool source) {
         AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), filename);
         cfilep->slow(slow);
@@ -102,6 +157,8 @@ public:
                 }
             }
         }
+        const string backendArgs = rfBackendArgs(nodep);
+        if (backendArgs != "") args += (args != "" ? ", " : "") + backendArgs;
         return args;
     }
 
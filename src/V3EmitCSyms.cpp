@@ -502,6 +502,7 @@ void EmitCSyms::emitSymHdr() {
     puts("} // end of namespace RF ==================================== \n");
 
     ofp()->putsEndGuard();
+    m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
 }
 
@@ -509,6 +510,7 @@ void EmitCSyms::closeSplit() {
     if (!m_ofp || m_ofp == m_ofpBase) return;
 
     puts("}\n");
+    m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
 }
 
@@ -522,8 +524,8 @@ void EmitCSyms::checkSplit(bool usesVfinal) {
     v3Global.useParallelBuild(true);
 
     m_numStmts = 0;
-    string filename
-        = v3Global.opt.makeDir() + "/" + symClassName() + "__" + cvtToStr(++m_funcNum) + ".cu";
+    string filename = v3Global.opt.makeDir() + "/" + symClassName() + "__"
+                      + cvtToStr(++m_funcNum) + rfSourceExt();
     AstCFile* cfilep = newCFile(filename, true /*slow*/, true /*source*/);
     cfilep->support(true);
     m_usesVfinal[m_funcNum] = usesVfinal;
@@ -603,7 +605,7 @@ void EmitCSyms::emitScopeHier(bool destroy) {
 
 void EmitCSyms::emitSymImp() {
     UINFO(6, __FUNCTION__ << ": " << endl);
-    string filename = v3Global.opt.makeDir() + "/" + symClassName() + ".cu";
+    string filename = v3Global.opt.makeDir() + "/" + symClassName() + rfSourceExt();
     AstCFile* cfilep = newCFile(filename, true /*slow*/, true /*source*/);
     cfilep->support(true);
 
@@ -875,6 +877,7 @@ void EmitCSyms::emitSymImp() {
     m_ofpBase->puts("}\n");
     puts("} // end of namespace RF ==================================== \n");
     closeSplit();
+    if (m_ofp) m_ofp->close();
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
 }
 
@@ -931,7 +934,7 @@ void EmitCSyms::emitDpiHdr() {
 
 void EmitCSyms::emitDpiImp() {
     UINFO(6, __FUNCTION__ << ": " << endl);
-    string filename = v3Global.opt.makeDir() + "/" + topClassName() + "__Dpi.cu";
+    string filename = v3Global.opt.makeDir() + "/" + topClassName() + "__Dpi" + rfSourceExt();
     AstCFile* cfilep = newCFile(filename, false /*slow*/, true /*source*/);
     cfilep->support(true);
     V3OutCFile hf(filename);
@@ -57,6 +57,10 @@ public:
         of.puts("VM_PARALLEL_BUILDS = ");
         of.puts(v3Global.useParallelBuild() ? "1" : "0");
         of.puts("\n");
+        of.puts("# RTLflow host backend?  0/1 (from --rtlflow-backend cpu)\n");
+        of.puts("VM_RTLFLOW_CPU = ");
+        of.puts(v3Global.opt.rtlflowCpu() ? "1" : "0");
+        of.puts("\n");
         of.puts("# Threaded output mode?  0/1/N threads (from --threads)\n");
         of.puts("VM_THREADS = ");
         of.puts(cvtToStr(v3Global.opt.threads()));
@@ -232,7 +236,8 @@ public:
                 string basename = V3Os::filenameNonExt(cppfile);
                 // NOLINTNEXTLINE(performance-inefficient-string-concatenation)
                 of.puts(basename + ".o: " + cppfile + "\n");
-                of.puts("\t$(OBJCACHE) $(CXX) $(CXXFLAGS) $(CPPFLAGS) $(OPT_FAST) $(RTLFLOW_FLAGS) -dc -o $@ $<\n");
+                of.puts("\t$(OBJCACHE) $(CXX) $(CXXFLAGS) $(CPPFLAGS) $(OPT_FAST) $(RTLFLOW_FLAGS) "
+                        "$(RTLFLOW_COMPILE) -o $@ $<\n");
             }
 
             of.puts("\n### Link rules... (from --exe)\n");
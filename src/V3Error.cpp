@@ -33,6 +33,7 @@ int V3Error::s_errorLimit = V3Error::MAX_ERRORS;
 bool V3Error::s_warnFatal = true;
 int V3Error::s_tellManual = 0;
 std::ostringstream V3Error::s_errorStr;  // Error string being formed
+std::recursive_mutex V3Error::s_mutex;
 V3ErrorCode V3Error::s_errorCode = V3ErrorCode::EC_FATAL;
 bool V3Error::s_errorContexted = false;
 bool V3Error::s_errorSuppressed = false;
@@ -184,6 +185,7 @@ void V3Error::suppressThisWarning() {
 string V3Error::warnMore() { return string(msgPrefix().size(), ' '); }
 
 void V3Error::v3errorEnd(std::ostringstream& sstr, const string& locationStr) {
+    const std::unique_lock<std::recursive_mutex> lock{s_mutex, std::adopt_lock};
 #if defined(__COVERITY__) || defined(__cppcheck__)
     if (s_errorCode == V3ErrorCode::EC_FATAL) __coverity_panic__(x);
 #endif
@@ -28,6 +28,7 @@
 #include <cassert>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 
@@ -250,6 +251,7 @@ private:
     static int s_warnCount;  // Warning count
     static int s_tellManual;  // Tell user to see manual, 0=not yet, 1=doit, 2=disable
     static std::ostringstream s_errorStr;  // Error string being formed
+    static std::recursive_mutex s_mutex;  // Held from v3errorPrep to v3errorEnd
     static V3ErrorCode s_errorCode;  // Error string being formed will abort
     static bool s_errorContexted;  // Error being formed got context
     static bool s_errorSuppressed;  // Error being formed should be suppressed
@@ -303,6 +305,8 @@ public:
     // Internals for v3error()/v3fatal() macros only
     // Error end takes the string stream to output, be careful to seek() as needed
     static void v3errorPrep(V3ErrorCode code) {
+        // Released by v3errorEnd, so messages from V3ThreadPool jobs don't mix
+        s_mutex.lock();
         s_errorStr.str("");
         s_errorCode = code;
         s_errorContexted = false;
@@ -29,6 +29,7 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -106,6 +107,7 @@ class V3FileDependImp final {
     // MEMBERS
     std::set<string> m_filenameSet;  // Files generated (elim duplicates)
     std::set<DependFile> m_filenameList;  // Files sourced/generated
+    std::mutex m_mutex;  // Files may be opened from V3ThreadPool jobs
 
     static string stripQuotes(const string& in) {
         string pretty = in;
@@ -118,6 +120,7 @@ class V3FileDependImp final {
 public:
     // ACCESSOR METHODS
     void addSrcDepend(const string& filename) {
+        const std::lock_guard<std::mutex> lock{m_mutex};
         if (m_filenameSet.find(filename) == m_filenameSet.end()) {
             // cppcheck-suppress stlFindInsert  // cppcheck 1.90 bug
             m_filenameSet.insert(filename);
@@ -127,6 +130,7 @@ public:
         }
     }
     void addTgtDepend(const string& filename) {
+        const std::lock_guard<std::mutex> lock{m_mutex};
         if (m_filenameSet.find(filename) == m_filenameSet.end()) {
             // cppcheck-suppress stlFindInsert  // cppcheck 1.90 bug
             m_filenameSet.insert(filename);
@@ -316,12 +320,11 @@ void V3File::createMakeDirFor(const string& filename) {
     }
 }
 void V3File::createMakeDir() {
-    static bool created = false;
-    if (!created) {
-        created = true;
+    static std::once_flag s_created;
+    std::call_once(s_created, []() {
         V3Os::createDir(v3Global.opt.makeDir());
         if (v3Global.opt.hierTop()) V3Os::createDir(v3Global.opt.hierTopDataDir());
-    }
+    });
 }
 
 //######################################################################
@@ -626,16 +629,8 @@ V3OutFormatter::V3OutFormatter(const string& filename, V3OutFormatter::Language
 
 string V3OutFormatter::indentSpaces(int num) {
     // Indent the specified number of spaces.  Use spaces.
-    static char str[MAXSPACE + 20];
-    char* cp = str;
     if (num > MAXSPACE) num = MAXSPACE;
-    while (num > 0) {
-        *cp++ = ' ';
-        --num;
-    }
-    *cp++ = '\0';
-    string st(str);
-    return st;
+    return string(num > 0 ? num : 0, ' ');
 }
 
 bool V3OutFormatter::tokenStart(const char* cp, const char* cmp) {
@@ -921,14 +916,48 @@ void V3OutFormatter::printf(const char* fmt...) {
 
 V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
     : V3OutFormatter{filename, lang} {
-    if ((m_fp = V3File::new_fopen_w(filename)) == nullptr) {
-        v3fatal("Cannot write " << filename);
-    }
+    V3File::createMakeDirFor(filename);
+    V3File::addTgtDepend(filename);
+    m_buffer.reserve(1024 * 1024);
 }
 
-V3OutFile::~V3OutFile() {
-    if (m_fp) fclose(m_fp);
-    m_fp = nullptr;
+V3OutFile::~V3OutFile() { close(); }
+
+void V3OutFile::close() {
+    if (m_closed) return;
+    m_closed = true;
+    const string contents = std::move(m_buffer);
+    if (filename() == VL_DEV_NULL) return;
+    // Leave a file with identical contents alone, keeping its mtime, so
+    // that make only rebuilds the objects of the files that changed
+    {
+        std::ifstream is{filename().c_str(), std::ios::in | std::ios::binary};
+        if (is) {
+            is.seekg(0, std::ios::end);
+            if (static_cast<size_t>(is.tellg()) == contents.size()) {
+                string old(contents.size(), '\0');
+                is.seekg(0, std::ios::beg);
+                is.read(&old[0], old.size());
+                if (is && old == contents) {
+                    UINFO(4, "Unchanged, not rewritten: " << filename() << endl);
+                    return;
+                }
+            }
+        }
+    }
+    // Write then rename, so that a failed write never leaves a truncated file
+    const string tmpname = filename() + "." + cvtToStr(V3Os::processId()) + ".tmp";
+    FILE* const fp = fopen(tmpname.c_str(), "wb");
+    if (!fp) v3fatal("Cannot write " << tmpname);
+    const bool written = fwrite(contents.data(), 1, contents.size(), fp) == contents.size();
+    if (fclose(fp) || !written) {
+        std::remove(tmpname.c_str());
+        v3fatal("Cannot write " << filename());
+    }
+    if (std::rename(tmpname.c_str(), filename().c_str())) {
+        std::remove(tmpname.c_str());
+        v3fatal("Cannot write " << filename());
+    }
 }
 
 void V3OutFile::putsForceIncs() {
@@ -179,16 +179,20 @@ public:
 
 class V3OutFile VL_NOT_FINAL : public V3OutFormatter {
     // MEMBERS
-    FILE* m_fp;
+    string m_buffer;  // Contents, written when closed unless the file already holds them
+    bool m_closed = false;  // close() called
 
 public:
     V3OutFile(const string& filename, V3OutFormatter::Language lang);
     virtual ~V3OutFile() override;
+    // Write the file, unless unchanged, reporting errors; the destructor
+    // closes a file not closed explicitly
+    void close();
     void putsForceIncs();
 
 private:
     // CALLBACKS
-    virtual void putcOutput(char chr) override { fputc(chr, m_fp); }
+    virtual void putcOutput(char chr) override { m_buffer += chr; }
 };
 
 class V3OutCFile VL_NOT_FINAL : public V3OutFile {
@@ -19,6 +19,7 @@
 
 #include "V3Global.h"
 #include "V3Ast.h"
+#include "V3AstArena.h"
 #include "V3File.h"
 #include "V3HierBlock.h"
 #include "V3LinkCells.h"
@@ -95,6 +96,8 @@ string V3Global::digitsFilename(int number) {
 void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool doDump) {
     v3Global.rootp()->dumpTreeFile(v3Global.debugFilename(stagename + ".tree", newNumber), false,
                                    doDump);
+    // Pass boundary, return what the pass freed
+    V3AstArena::trim();
     if (v3Global.opt.stats()) V3Stats::statsStage(stagename);
 }
 
@@ -103,6 +103,7 @@ class V3Global final {
     bool m_dpi = false;  // Need __Dpi include files
     bool m_useParallelBuild = false;  // Use parallel build for model
     bool m_useRandomizeMethods = false;  // Need to define randomize() class methods
+    bool m_rtlflowChangeDet = true;  // RTLflow: some signal needs change detection
 
     // Memory address to short string mapping (for debug)
     std::unordered_map<const void*, std::string>
@@ -157,6 +158,8 @@ public:
     bool useParallelBuild() const { return m_useParallelBuild; }
     void useRandomizeMethods(bool flag) { m_useRandomizeMethods = flag; }
     bool useRandomizeMethods() const { return m_useRandomizeMethods; }
+    void rtlflowChangeDet(bool flag) { m_rtlflowChangeDet = flag; }
+    bool rtlflowChangeDet() const { return m_rtlflowChangeDet; }
     const std::string& ptrToId(const void* p);
 };
 
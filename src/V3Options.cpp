@@ -725,6 +725,13 @@ void V3Options::notify() {
     // Make sure at least one make system is enabled
     if (!m_gmake && !m_cmake) m_gmake = true;
 
+    if (m_rtlflowSimd && !rtlflowCpu()) {
+        cmdfl->v3error("--rtlflow-simd requires --rtlflow-backend cpu");
+    }
+    if (m_rtlflowBitslice && !rtlflowCpu()) {
+        cmdfl->v3error("--rtlflow-bitslice requires --rtlflow-backend cpu");
+    }
+
     if (m_hierarchical && (m_hierChild || !m_hierBlocks.empty())) {
         cmdfl->v3error(
             "--hierarchical must not be set with --hierarchical-child or --hierarchical-block");
@@ -1219,6 +1226,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     });
     DECL_OPTION("-pins-uint8", OnOff, &m_pinsUint8);
     DECL_OPTION("-pipe-filter", Set, &m_pipeFilter);
+    DECL_OPTION("-pp-cache", Set, &m_ppCache);
     DECL_OPTION("-pp-comments", OnOff, &m_ppComments);
     DECL_OPTION("-prefix", CbVal, [this](const char* valp) {
         m_prefix = valp;
@@ -1253,6 +1261,32 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         if (m_reloopLimit < 2) { fl->v3error("--reloop-limit must be >= 2: " << valp); }
     });
     DECL_OPTION("-report-unoptflat", OnOff, &m_reportUnoptflat);
+    DECL_OPTION("-rtlflow-active-set", OnOff, &m_rtlflowActiveSet);
+    DECL_OPTION("-rtlflow-backend", CbVal, [this, fl](const char* valp) {
+        if (!strcmp(valp, "gpu")) {
+            m_rtlflowBackend = "gpu";
+        } else if (!strcmp(valp, "cpu")) {
+            m_rtlflowBackend = "cpu";
+        } else {
+            fl->v3fatal("Unknown setting for --rtlflow-backend: '"
+                        << valp << "'\n"
+                        << fl->warnMore() << "... Suggest 'gpu' or 'cpu'");
+        }
+    });
+    DECL_OPTION("-rtlflow-bitslice", OnOff, &m_rtlflowBitslice);
+    DECL_OPTION("-rtlflow-deltas", OnOff, &m_rtlflowDeltas);
+    DECL_OPTION("-rtlflow-dispatch-cost", CbVal, [this, fl](const char* valp) {
+        m_rtlflowDispatchCost = std::atoi(valp);
+        if (m_rtlflowDispatchCost < 0) {
+            fl->v3fatal("--rtlflow-dispatch-cost must be >= 0: " << valp);
+        }
+    });
+    DECL_OPTION("-rtlflow-display", OnOff, &m_rtlflowDisplay);
+    DECL_OPTION("-rtlflow-locality", OnOff, &m_rtlflowLocality);
+    DECL_OPTION("-rtlflow-prof", OnOff, &m_rtlflowProf);
+    DECL_OPTION("-rtlflow-prof-cost", Set, &m_rtlflowProfCost);
+    DECL_OPTION("-rtlflow-simd", OnOff, &m_rtlflowSimd);
+    DECL_OPTION("-rtlflow-trace", OnOff, &m_rtlflowTrace);
     DECL_OPTION("-rr", CbCall, []() {});  // Processed only in bin/verilator shell
 
     DECL_OPTION("-savable", OnOff, &m_savable);
@@ -1358,6 +1392,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         V3Options::addLibraryFile(parseFileArg(optdir, valp));
     });
     DECL_OPTION("-verilate", OnOff, &m_verilate);
+    DECL_OPTION("-verilate-jobs", CbVal, [this, fl](int val) {
+        if (val < 0) fl->v3error("--verilate-jobs must be >= 0: " << val);
+        m_verilateJobs = val;
+    });
     DECL_OPTION("-version", CbCall, [this]() {
         showVersion(false);
         std::exit(0);
@@ -1714,6 +1752,7 @@ V3Options::V3Options() {
     m_traceFormat = TraceFormat::VCD;
 
     m_makeDir = "obj_dir";
+    m_rtlflowBackend = "gpu";
     m_unusedRegexp = "*unused*";
     m_xAssign = "fast";
 
@@ -262,6 +262,14 @@ private:
     bool m_relativeCFuncs = true;   // main switch: --relative-cfuncs
     bool m_relativeIncludes = false; // main switch: --relative-includes
     bool m_reportUnoptflat = false; // main switch: --report-unoptflat
+    bool m_rtlflowActiveSet = false; // main switch: --rtlflow-active-set
+    bool m_rtlflowBitslice = false; // main switch: --rtlflow-bitslice
+    bool m_rtlflowDeltas = false;   // main switch: --rtlflow-deltas
+    bool m_rtlflowDisplay = false;  // main switch: --rtlflow-display
+    bool m_rtlflowLocality = false; // main switch: --rtlflow-locality
+    bool m_rtlflowProf = false;     // main switch: --rtlflow-prof
+    bool m_rtlflowSimd = false;     // main switch: --rtlflow-simd
+    bool m_rtlflowTrace = false;    // main switch: --rtlflow-trace
     bool m_savable = false;         // main switch: --savable
     bool m_structsPacked = true;    // main switch: --structs-packed
     bool m_systemC = false;         // main switch: --sc: System C instead of simple C++
@@ -297,6 +305,7 @@ private:
     int         m_outputSplitCTrace = -1;  // main switch: --output-split-ctrace
     int         m_pinsBv = 65;       // main switch: --pins-bv
     int         m_reloopLimit = 40; // main switch: --reloop-limit
+    int         m_rtlflowDispatchCost = 0;  // main switch: --rtlflow-dispatch-cost
     VOptionBool m_skipIdentical;  // main switch: --skip-identical
     int         m_threads = 0;      // main switch: --threads (0 == --no-threads)
     int         m_threadsMaxMTasks = 0;  // main switch: --threads-max-mtasks
@@ -311,6 +320,7 @@ private:
     int         m_traceThreads = 0; // main switch: --trace-threads
     int         m_unrollCount = 64;  // main switch: --unroll-count
     int         m_unrollStmts = 30000;  // main switch: --unroll-stmts
+    int         m_verilateJobs = 1;  // main switch: --verilate-jobs
 
     int         m_compLimitBlocks = 0;  // compiler selection; number of nested blocks
     int         m_compLimitMembers = 64;  // compiler selection; number of members in struct before make anon array
@@ -323,9 +333,12 @@ private:
     string      m_makeDir;      // main switch: -Mdir
     string      m_modPrefix;    // main switch: --mod-prefix
     string      m_pipeFilter;   // main switch: --pipe-filter
+    string      m_ppCache;      // main switch: --pp-cache {dir}
     string      m_prefix;       // main switch: --prefix
     string      m_protectKey;   // main switch: --protect-key
     string      m_protectLib;   // main switch: --protect-lib {lib_name}
+    string      m_rtlflowBackend;  // main switch: --rtlflow-backend
+    string      m_rtlflowProfCost;  // main switch: --rtlflow-prof-cost
     string      m_topModule;    // main switch: --top-module
     string      m_unusedRegexp; // main switch: --unused-regexp
     string      m_waiverOutput;  // main switch: --waiver-output {filename}
@@ -515,6 +528,7 @@ public:
     }
     int unrollCount() const { return m_unrollCount; }
     int unrollStmts() const { return m_unrollStmts; }
+    int verilateJobs() const { return m_verilateJobs; }
 
     int compLimitBlocks() const { return m_compLimitBlocks; }
     int compLimitMembers() const { return m_compLimitMembers; }
@@ -525,6 +539,7 @@ public:
     string makeDir() const { return m_makeDir; }
     string modPrefix() const { return m_modPrefix; }
     string pipeFilter() const { return m_pipeFilter; }
+    string ppCache() const { return m_ppCache; }
     string prefix() const { return m_prefix; }
     string protectKeyDefaulted();  // Set default key if not set by user
     string protectLib() const { return m_protectLib; }
@@ -537,6 +552,18 @@ public:
         }
         return libName;
     }
+    string rtlflowBackend() const { return m_rtlflowBackend; }
+    bool rtlflowCpu() const { return m_rtlflowBackend == "cpu"; }
+    bool rtlflowActiveSet() const { return m_rtlflowActiveSet; }
+    bool rtlflowSimd() const { return m_rtlflowSimd; }
+    bool rtlflowTrace() const { return m_rtlflowTrace; }
+    bool rtlflowBitslice() const { return m_rtlflowBitslice; }
+    bool rtlflowDeltas() const { return m_rtlflowDeltas; }
+    bool rtlflowDisplay() const { return m_rtlflowDisplay; }
+    bool rtlflowLocality() const { return m_rtlflowLocality; }
+    bool rtlflowProf() const { return m_rtlflowProf; }
+    int rtlflowDispatchCost() const { return m_rtlflowDispatchCost; }
+    string rtlflowProfCost() const { return m_rtlflowProfCost; }
     string topModule() const { return m_topModule; }
     string unusedRegexp() const { return m_unusedRegexp; }
     string waiverOutput() const { return m_waiverOutput; }
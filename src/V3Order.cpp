@@ -1890,6 +1890,8 @@ void OrderVisitor::processMTasks() {
                 if (!post_varp) continue;
                 AstVar* varp = post_varp->varScp()->varp();
                 varp->addConsumingMTaskId(mtaskId);
+                // logicp writes varp; RTLflow groups shared vars by writer
+                varp->producerMTaskId(mtaskId);
             }
             // TODO? We ignore IO vars here, so those will have empty mtask
             // signatures. But we could also give those mtask signatures.
@@ -1940,6 +1942,7 @@ void OrderVisitor::processMTasks() {
         // - The ExecMTask graph and the AstMTaskBody's produced here
         //   persist until code generation time.
         state.m_execMTaskp = new ExecMTask(execGraphp->mutableDepGraphp(), bodyp, mtaskp->id());
+        state.m_execMTaskp->hash(V3Partition::mtaskHash(mtaskp));
         // Cross-link each ExecMTask and MTaskBody
         //  Q: Why even have two objects?
         //  A: One is an AstNode, the other is a GraphVertex,
@@ -60,6 +60,7 @@
 #  endif
 # endif
 #else
+# include <sys/resource.h>  // getrusage
 # include <sys/time.h>
 # include <sys/wait.h> // Needed on FreeBSD for WIFEXITED
 # include <unistd.h>  // usleep
@@ -330,6 +331,32 @@ uint64_t V3Os::memUsageBytes() {
 #endif
 }
 
+uint64_t V3Os::memPeakBytes() {
+#if defined(_WIN32) || defined(__MINGW32__)
+    HANDLE process = GetCurrentProcess();
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(process, &pmc, sizeof(pmc))) return pmc.PeakWorkingSetSize;
+    return 0;
+#else
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);  // Bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // Kilobytes
+#endif
+#endif
+}
+
+uint64_t V3Os::processId() {
+#if defined(_WIN32) || defined(__MINGW32__)
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
 void V3Os::u_sleep(int64_t usec) {
 #if defined(_WIN32) || defined(__MINGW32__)
     std::this_thread::sleep_for(std::chrono::microseconds(usec));
@@ -65,10 +65,12 @@ public:
     /// Return wall time since epoch in microseconds, or 0 if not implemented
     static uint64_t timeUsecs();
     static uint64_t memUsageBytes();  ///< Return memory usage in bytes, or 0 if not implemented
+    static uint64_t memPeakBytes();  ///< Return peak resident memory in bytes, or 0 if unknown
 
     // METHODS (sub command)
     /// Run system command, returns the exit code of the child process.
     static int system(const string& command);
+    static uint64_t processId();  ///< Return the id of this process
 };
 
 #endif  // Guard
@@ -27,8 +27,13 @@
 #include "V3Scoreboard.h"
 #include "V3Stats.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 
 class MergeCandidate;
@@ -347,6 +352,61 @@ public:
     static void selfTest() { PartPropagateCpSelfTest().go(); }
 };
 
+//######################################################################
+// PartCostProfile
+
+// RTLflow: --rtlflow-prof-cost. Measured mtask costs per call from the
+// .cost file written by RTLflow::profile() of a previous run, keyed by
+// mtask hash and scaled so that the profiled mtasks keep their total
+// estimated cost.
+class PartCostProfile final {
+    std::unordered_map<vluint64_t, uint32_t> m_costs;  // Measured cost by mtask hash
+
+    PartCostProfile() {
+        const string filename = v3Global.opt.rtlflowProfCost();
+        if (filename.empty()) return;
+        const std::unique_ptr<std::ifstream> ifp(V3File::new_ifstream(filename));
+        if (ifp->fail()) v3fatal("Cannot open --rtlflow-prof-cost file: " << filename);
+        std::vector<std::pair<vluint64_t, double>> measured;
+        double totalEst = 0;
+        double totalMeasured = 0;
+        string line;
+        while (std::getline(*ifp, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream is(line);
+            vluint64_t hash;
+            uint32_t est;
+            double us;
+            size_t calls;
+            if (!(is >> std::hex >> hash >> std::dec >> est >> us >> calls)) {
+                v3fatal("Malformed line in --rtlflow-prof-cost file " << filename << ": " << line);
+            }
+            if (!calls) continue;
+            // The estimate is of one call, the measure of them all
+            measured.emplace_back(hash, us / calls);
+            totalEst += est;
+            totalMeasured += us / calls;
+        }
+        const double scale = totalMeasured > 0 ? totalEst / totalMeasured : 0;
+        for (const auto& it : measured) {
+            m_costs[it.first] = std::max<uint32_t>(1, static_cast<uint32_t>(it.second * scale));
+        }
+    }
+    static PartCostProfile& singleton() {
+        static PartCostProfile s_profile;
+        return s_profile;
+    }
+
+public:
+    static bool empty() { return singleton().m_costs.empty(); }
+    static bool find(vluint64_t hash, uint32_t& costr) {
+        const auto it = singleton().m_costs.find(hash);
+        if (it == singleton().m_costs.end()) return false;
+        costr = it->second;
+        return true;
+    }
+};
+
 //######################################################################
 // LogicMTask
 
@@ -429,6 +489,9 @@ private:
 
     uint32_t m_serialId;  // Unique MTask ID number
 
+    // Sorted V3Partition::vertexHash of m_vertices, kept under --rtlflow-prof-cost
+    std::vector<vluint64_t> m_hashes;
+
     // Count "generations" which are just operations that scan through the
     // graph. We'll mark each node with the last generation that scanned
     // it. We can use this to avoid recursing through the same node twice
@@ -455,6 +518,10 @@ public:
             if (OrderLogicVertex* olvp = mtmvVxp->logicp()) {
                 m_cost += V3InstrCount::count(olvp->nodep(), true);
             }
+            if (!PartCostProfile::empty()) {
+                m_hashes.push_back(V3Partition::vertexHash(mtmvVxp));
+                PartCostProfile::find(V3Partition::combineHashes(m_hashes), m_cost /*ref*/);
+            }
         }
         // Start at 1, so that 0 indicates no mtask ID.
         static uint32_t s_nextId = 1;
@@ -464,9 +531,26 @@ public:
 
     // METHODS
     void moveAllVerticesFrom(LogicMTask* otherp) {
+        m_cost = mergedCost(this, otherp);
+        if (!PartCostProfile::empty()) m_hashes = mergedHashes(this, otherp);
         // splice() is constant time
         m_vertices.splice(m_vertices.end(), otherp->m_vertices);
-        m_cost += otherp->m_cost;
+    }
+    // Cost of the mtask merging ap and bp: the measured cost when the
+    // merged mtask matches one of --rtlflow-prof-cost, else the sum
+    static uint32_t mergedCost(const LogicMTask* ap, const LogicMTask* bp) {
+        uint32_t cost = ap->m_cost + bp->m_cost;
+        if (!PartCostProfile::empty()) {
+            PartCostProfile::find(V3Partition::combineHashes(mergedHashes(ap, bp)), cost);
+        }
+        return cost;
+    }
+    static std::vector<vluint64_t> mergedHashes(const LogicMTask* ap, const LogicMTask* bp) {
+        std::vector<vluint64_t> hashes;
+        hashes.reserve(ap->m_hashes.size() + bp->m_hashes.size());
+        std::merge(ap->m_hashes.begin(), ap->m_hashes.end(), bp->m_hashes.begin(),
+                   bp->m_hashes.end(), std::back_inserter(hashes));
+        return hashes;
     }
     virtual const VxList* vertexListp() const override { return &m_vertices; }
     static vluint64_t incGeneration() {
@@ -828,6 +912,7 @@ class PartParallelismEst final {
     // Cost of the longest critical path, in abstract units (the same units
     // returned by the vertexCost)
     uint32_t m_longestCpCost = 0;
+    uint32_t m_longestCpVertexes = 0;  // Vertexes on the longest critical path
 
     size_t m_vertexCount = 0;  // Number of vertexes calculated
     size_t m_edgeCount = 0;  // Number of edges calculated
@@ -840,6 +925,7 @@ public:
     // METHODS
     uint32_t totalGraphCost() const { return m_totalGraphCost; }
     uint32_t longestCritPathCost() const { return m_longestCpCost; }
+    uint32_t longestCritPathVertexes() const { return m_longestCpVertexes; }
     size_t vertexCount() const { return m_vertexCount; }
     size_t edgeCount() const { return m_edgeCount; }
     double parallelismFactor() const {
@@ -848,25 +934,35 @@ public:
     void traverse() {
         // For each node, record the critical path cost from the start
         // of the graph through the end of the node.
-        std::unordered_map<const V3GraphVertex*, uint32_t> critPaths;
+        // Also count the vertexes along that path.
+        std::unordered_map<const V3GraphVertex*, std::pair<uint32_t, uint32_t>> critPaths;
         GraphStreamUnordered serialize(m_graphp);
         for (const V3GraphVertex* vertexp; (vertexp = serialize.nextp());) {
             m_vertexCount++;
             uint32_t cpCostToHere = 0;
+            uint32_t cpVertexesToHere = 0;
             for (V3GraphEdge* edgep = vertexp->inBeginp(); edgep; edgep = edgep->inNextp()) {
                 ++m_edgeCount;
                 // For each upstream item, add its critical path cost to
                 // the cost of this edge, to form a new candidate critical
                 // path cost to the current node. Whichever is largest is
                 // the critical path to reach the start of this node.
-                cpCostToHere = std::max(cpCostToHere, critPaths[edgep->fromp()]);
+                const auto& fromCp = critPaths[edgep->fromp()];
+                if (fromCp.first >= cpCostToHere) {
+                    cpCostToHere = fromCp.first;
+                    cpVertexesToHere = fromCp.second;
+                }
             }
             // Include the cost of the current vertex in the critical
             // path, so it represents the critical path to the end of
             // this vertex.
             cpCostToHere += vertexCost(vertexp);
-            critPaths[vertexp] = cpCostToHere;
-            m_longestCpCost = std::max(m_longestCpCost, cpCostToHere);
+            ++cpVertexesToHere;
+            critPaths[vertexp] = std::make_pair(cpCostToHere, cpVertexesToHere);
+            if (cpCostToHere >= m_longestCpCost) {
+                m_longestCpCost = cpCostToHere;
+                m_longestCpVertexes = cpVertexesToHere;
+            }
             // Tally the total cost contributed by vertices.
             m_totalGraphCost += vertexCost(vertexp);
         }
@@ -1055,6 +1151,10 @@ private:
     V3Scoreboard<MergeCandidate, uint32_t> m_sb;  // Scoreboard
     SibSet m_pairs;  // Storage for each SiblingMC
     MTask2Sibs m_mtask2sibs;  // SiblingMC set for each mtask
+    // RTLflow: --rtlflow-dispatch-cost objective, see dispatchCost()
+    uint32_t m_dispatchCost = 0;  // Dispatch cost of one mtask, 0 for a fixed m_scoreLimit
+    uint32_t m_totalCost = 0;  // Total graph cost
+    size_t m_mtaskCount = 0;  // Mtasks remaining
 
 public:
     // CONSTRUCTORS
@@ -1065,10 +1165,30 @@ public:
         , m_sb{&mergeCandidateScore, slowAsserts} {}
 
     // METHODS
+    // RTLflow: instead of stopping at the fixed scoreLimit, keep merging
+    // while the critical path stays below the scoreLimit (the critical path
+    // before contraction) stretched by the share of the total cost that the
+    // remaining mtasks spend on dispatch. Each merge saves one dispatch and
+    // lowers the limit, so contraction stops where a longer critical path
+    // would cost more than the dispatch overhead it saves.
+    void dispatchCost(uint32_t dispatchCost, uint32_t totalCost) {
+        m_dispatchCost = dispatchCost;
+        m_totalCost = std::max<uint32_t>(1, totalCost);
+    }
+    uint32_t scoreLimit() const {
+        if (!m_dispatchCost) return m_scoreLimit;
+        const double stretch = static_cast<double>(m_scoreLimit) * m_mtaskCount * m_dispatchCost
+                               / m_totalCost;
+        return m_scoreLimit + static_cast<uint32_t>(std::min<double>(stretch, 0x7fffffff));
+    }
+
     void go() {
         unsigned maxMTasks = v3Global.opt.threadsMaxMTasks();
         if (maxMTasks == 0) {  // Unspecified so estimate
-            if (v3Global.opt.threads() > 1) {
+            if (m_dispatchCost) {
+                // RTLflow: scoreLimit() already weighs the mtask count
+                maxMTasks = 0xffffffff;
+            } else if (v3Global.opt.threads() > 1) {
                 maxMTasks = (PART_DEFAULT_MAX_MTASKS_PER_THREAD * v3Global.opt.threads());
             } else {
                 // Running PartContraction with --threads <= 1 means self-test
@@ -1099,6 +1219,10 @@ public:
 
         doRescore();  // Set initial scores in scoreboard
 
+        for (V3GraphVertex* vxp = m_mtasksp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+            ++m_mtaskCount;
+        }
+
         while (true) {
             // This is the best edge to merge, with the lowest
             // score (shortest local critical path)
@@ -1129,7 +1253,7 @@ public:
             // ... we'll also confirm that actualScore hasn't shrunk relative
             // to cached score, after the mergeWouldCreateCycle() check.
 
-            if (actualScore > m_scoreLimit) {
+            if (actualScore > scoreLimit()) {
                 // Our best option isn't good enough
                 if (m_sb.needsRescore()) {
                     // Some pairs need a rescore, maybe those will be
@@ -1209,6 +1333,7 @@ public:
 
             // Finally merge this candidate.
             contract(mergeCanp);
+            --m_mtaskCount;
         }
     }
 
@@ -1231,7 +1356,8 @@ private:
         }
 
         uint32_t origRelativesCp = mtaskp->critPathCost(way) + mtaskp->stepCost();
-        uint32_t newRelativesCp = newCp + LogicMTask::stepCost(mtaskp->cost() + otherp->cost());
+        uint32_t newRelativesCp
+            = newCp + LogicMTask::stepCost(LogicMTask::mergedCost(mtaskp, otherp));
 
         NewCp result;
         result.cp = newCp;
@@ -1420,7 +1546,8 @@ private:
             = std::max(ap->critPathCost(GraphWay::FORWARD), bp->critPathCost(GraphWay::FORWARD));
         uint32_t mergedCpCostRev
             = std::max(ap->critPathCost(GraphWay::REVERSE), bp->critPathCost(GraphWay::REVERSE));
-        return mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(ap->cost() + bp->cost());
+        return mergedCpCostRev + mergedCpCostFwd
+               + LogicMTask::stepCost(LogicMTask::mergedCost(ap, bp));
     }
 
     static uint32_t edgeScore(const V3GraphEdge* edgep) {
@@ -1434,7 +1561,7 @@ private:
         uint32_t mergedCpCostRev = std::max(fromp->critPathCostWithout(GraphWay::REVERSE, edgep),
                                             top->critPathCost(GraphWay::REVERSE));
         return mergedCpCostRev + mergedCpCostFwd
-               + LogicMTask::stepCost(fromp->cost() + top->cost());
+               + LogicMTask::stepCost(LogicMTask::mergedCost(fromp, top));
     }
 
     void makeSiblingMC(LogicMTask* ap, LogicMTask* bp) {
@@ -2423,6 +2550,17 @@ void V3Partition::go(V3Graph* mtasksp) {
     unsigned fudgeNumerator = 3;
     unsigned fudgeDenominator = 5;
     uint32_t cpLimit = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
+
+    // RTLflow: every stimulus of the batch runs each mtask, so the threads
+    // only set how many mtasks run side by side and the useful mtask count
+    // is decided by the dispatch cost instead; see
+    // PartContraction::dispatchCost().
+    const uint32_t dispatchCost = v3Global.opt.rtlflowDispatchCost();
+    if (dispatchCost) {
+        PartParallelismEst est(mtasksp);
+        est.traverse();
+        cpLimit = est.longestCritPathCost();
+    }
     UINFO(4, "V3Partition set cpLimit = " << cpLimit << endl);
 
     // Merge MTask nodes together, repeatedly, until the CP budget is
@@ -2432,17 +2570,19 @@ void V3Partition::go(V3Graph* mtasksp) {
     // Some tests disable this, hence the test on threadsCoarsen().
     // Coarsening is always enabled in production.
     if (v3Global.opt.threadsCoarsen()) {
-        PartContraction(mtasksp, cpLimit,
-                        // --debugPartition is used by tests
-                        // to enable slow assertions.
-                        v3Global.opt.debugPartition())
-            .go();
+        PartContraction contraction(mtasksp, cpLimit,
+                                    // --debugPartition is used by tests
+                                    // to enable slow assertions.
+                                    v3Global.opt.debugPartition());
+        if (dispatchCost) contraction.dispatchCost(dispatchCost, totalGraphCost);
+        contraction.go();
         V3Partition::debugMTaskGraphStats(mtasksp, "contraction");
     }
     {
         mtasksp->removeTransitiveEdges();
         V3Partition::debugMTaskGraphStats(mtasksp, "transitive1");
     }
+    if (dispatchCost) dispatchReport(mtasksp, dispatchCost);
 
     // Reassign MTask IDs onto smaller numbers, which should be more stable
     // across small logic changes.  Keep MTask IDs in the same relative
@@ -2478,12 +2618,66 @@ void V3Partition::go(V3Graph* mtasksp) {
     }
 }
 
+void V3Partition::dispatchReport(const V3Graph* mtasksp, uint32_t dispatchCost) {
+    // RTLflow: predicted cost of one cycle for the chosen mtask granularity,
+    // the critical path against the dispatches along it and in total
+    PartParallelismEst est(mtasksp);
+    est.traverse();
+    const double cpDispatch = static_cast<double>(est.longestCritPathVertexes()) * dispatchCost;
+    const double totalDispatch = static_cast<double>(est.vertexCount()) * dispatchCost;
+    V3Stats::addStat("RTLflow, partition, mtasks", est.vertexCount());
+    V3Stats::addStat("RTLflow, partition, mtasks on critical path", est.longestCritPathVertexes());
+    V3Stats::addStat("RTLflow, partition, critical path cost", est.longestCritPathCost());
+    V3Stats::addStat("RTLflow, partition, critical path dispatch cost", cpDispatch);
+    V3Stats::addStat("RTLflow, partition, predicted cycle cost",
+                     est.longestCritPathCost() + cpDispatch);
+    V3Stats::addStat("RTLflow, partition, total graph cost", est.totalGraphCost());
+    V3Stats::addStat("RTLflow, partition, total dispatch cost", totalDispatch);
+    UINFO(1, "RTLflow partition: " << est.vertexCount() << " mtasks, critical path "
+                                    << est.longestCritPathCost() << " + dispatch " << cpDispatch
+                                    << " over " << est.longestCritPathVertexes() << " mtasks"
+                                    << endl);
+}
+
+vluint64_t V3Partition::vertexHash(const MTaskMoveVertex* mvertexp) {
+    const OrderLogicVertex* logicp = mvertexp->logicp();
+    if (!logicp) return 0;
+    const AstNode* nodep = logicp->nodep();
+    const FileLine* flp = nodep->fileline();
+    const string key = V3Os::filenameNonDir(flp->filename()) + ":"
+                       + cvtToStr(flp->firstLineno()) + ":" + cvtToStr(flp->firstColumn()) + " "
+                       + nodep->typeName() + " " + (logicp->scopep() ? logicp->scopep()->name() : "");
+    const V3Hash hash{key};
+    return (static_cast<vluint64_t>(hash.value()) << 32) | (hash + key).value();
+}
+
+vluint64_t V3Partition::combineHashes(const std::vector<vluint64_t>& sortedHashes) {
+    // Sorted, so independent of the order the vertices were merged in;
+    // unlike a sum, sets with equal sums, or repeated vertex hashes, differ
+    vluint64_t hash = 0xcbf29ce484222325ULL;
+    for (const vluint64_t value : sortedHashes) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+vluint64_t V3Partition::mtaskHash(const AbstractLogicMTask* mtaskp) {
+    std::vector<vluint64_t> hashes;
+    for (const MTaskMoveVertex* mvertexp : *mtaskp->vertexListp()) {
+        hashes.push_back(vertexHash(mvertexp));
+    }
+    std::sort(hashes.begin(), hashes.end());
+    return combineHashes(hashes);
+}
+
 void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp) {
     GraphStreamUnordered ser(execMTaskGraphp, GraphWay::REVERSE);
+    size_t profiled = 0;
 
     while (const V3GraphVertex* vxp = ser.nextp()) {
         ExecMTask* mtp = dynamic_cast<ExecMTask*>(const_cast<V3GraphVertex*>(vxp));
         uint32_t costCount = V3InstrCount::count(mtp->bodyp(), false);
+        if (PartCostProfile::find(mtp->hash(), costCount /*ref*/)) ++profiled;
         mtp->cost(costCount);
         mtp->priority(costCount);
 
@@ -2500,6 +2694,8 @@ void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp) {
         }
     }
 
+    if (!PartCostProfile::empty()) V3Stats::addStat("RTLflow, mtasks with profiled cost", profiled);
+
     // Some MTasks may now have zero cost, eliminate those.
     // (It's common for tasks to shrink to nothing when V3LifePost
     // removes dly assignments.)
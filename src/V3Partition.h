@@ -24,7 +24,9 @@
 #include "V3OrderGraph.h"
 
 #include <list>
+#include <vector>
 
+class AbstractLogicMTask;
 class LogicMTask;
 using Vx2MTaskMap = std::unordered_map<const MTaskMoveVertex*, LogicMTask*>;
 
@@ -62,6 +64,14 @@ public:
     // generation time.
     static void finalize();
 
+    // RTLflow: --rtlflow-dispatch-cost report of the contracted graph
+    static void dispatchReport(const V3Graph* mtasksp, uint32_t dispatchCost);
+    // RTLflow: stable identity of logic across verilator runs; the hash of
+    // an mtask combines the sorted hashes of its vertices
+    static vluint64_t vertexHash(const MTaskMoveVertex* mvertexp);
+    static vluint64_t combineHashes(const std::vector<vluint64_t>& sortedHashes);
+    static vluint64_t mtaskHash(const AbstractLogicMTask* mtaskp);
+
 private:
     static void finalizeCosts(V3Graph* execMTaskGraphp);
     static void setupMTaskDeps(V3Graph* mtasksp, const Vx2MTaskMap* vx2mtaskp);
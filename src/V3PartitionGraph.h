@@ -65,6 +65,7 @@ private:
     // or 0xffffffff if not yet assigned.
     const ExecMTask* m_packNextp = nullptr;  // Next for static (pack_mtasks) scheduling
     bool m_threadRoot = false;  // Is root thread
+    vluint64_t m_hash = 0;  // V3Partition::mtaskHash, stable across runs
     VL_UNCOPYABLE(ExecMTask);
 
 public:
@@ -84,6 +85,8 @@ public:
     const ExecMTask* packNextp() const { return m_packNextp; }
     bool threadRoot() const { return m_threadRoot; }
     void threadRoot(bool threadRoot) { m_threadRoot = threadRoot; }
+    vluint64_t hash() const { return m_hash; }
+    void hash(vluint64_t hash) { m_hash = hash; }
     string cFuncName() const {
         // If this MTask maps to a C function, this should be the name
         return string("__Vmtask") + "__" + cvtToStr(m_id);
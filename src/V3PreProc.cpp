@@ -246,6 +246,7 @@ public:
     void insertUnreadbackAtBol(const string& text);
     void addLineComment(int enterExit);
     void dumpDefines(std::ostream& os) override;
+    DefineState defineState() const override;
     void candidateDefines(VSpellCheck* spellerp) override;
 
     // METHODS, callbacks
@@ -885,6 +886,15 @@ void V3PreProcImp::dumpDefines(std::ostream& os) {
     }
 }
 
+V3PreProc::DefineState V3PreProcImp::defineState() const {
+    DefineState state;
+    for (const auto& itr : m_defines) {
+        state.emplace(itr.first, DefineValue{itr.second.params(), itr.second.value(),
+                                             itr.second.cmdline()});
+    }
+    return state;
+}
+
 void V3PreProcImp::candidateDefines(VSpellCheck* spellerp) {
     for (DefinesMap::const_iterator it = m_defines.begin(); it != m_defines.end(); ++it) {
         spellerp->pushCandidate(string("`") + it->first);
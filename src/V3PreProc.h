@@ -94,6 +94,19 @@ public:
     void error(const string& msg) { fileline()->v3error(msg); }  ///< Report an error
     void fatal(const string& msg) { fileline()->v3fatalSrc(msg); }  ///< Report a fatal error
     virtual void dumpDefines(std::ostream& os) = 0;  ///< Print list of `defines
+
+    // `define table, for the preprocessor cache of V3PreShell
+    struct DefineValue final {
+        string m_params;
+        string m_value;
+        bool m_cmdline;
+        bool operator==(const DefineValue& rhs) const {
+            return m_params == rhs.m_params && m_value == rhs.m_value
+                   && m_cmdline == rhs.m_cmdline;
+        }
+    };
+    using DefineState = std::map<string, DefineValue>;
+    virtual DefineState defineState() const = 0;  ///< Return the current `defines
     virtual void candidateDefines(VSpellCheck* spellerp) = 0;  ///< Spell check candidate defines
 
 protected:
@@ -23,9 +23,16 @@
 #include "V3File.h"
 #include "V3Parse.h"
 #include "V3Os.h"
+#include "V3Stats.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 //######################################################################
 
@@ -37,6 +44,10 @@ protected:
     static V3PreProc* s_preprocp;
     static VInFilter* s_filterp;
 
+    // --pp-cache state of the file being preprocessed
+    string m_cacheKey;  // Key of the entry being recorded, "" if none
+    std::vector<string> m_cacheIncludes;  // Name, lastpath, filename, hash of each `include
+
     //---------------------------------------
     // METHODS
 
@@ -95,7 +106,7 @@ protected:
 
         // Preprocess
         s_filterp = filterp;
-        string modfilename = preprocOpen(fl, s_filterp, modname, "", errmsg);
+        string modfilename = preprocFind(fl, modname, "", errmsg);
         if (modfilename.empty()) return false;
 
         // Set language standard up front
@@ -111,10 +122,38 @@ protected:
             // FileLine tracks and frees modfileline
         }
 
+        // Reuse the output of an earlier run, else record it
+        m_cacheKey.clear();
+        m_cacheIncludes.clear();
+        V3PreProc::DefineState defines;
+        if (!v3Global.opt.ppCache().empty() && v3Global.opt.pipeFilter().empty()) {
+            defines = s_preprocp->defineState();
+            string contents;
+            if (cacheReadFile(modfilename, contents)) {
+                m_cacheKey = cacheKey(modfilename, contents, defines);
+                if (cacheLoad(fl, modfilename, parsep)) {
+                    m_cacheKey.clear();
+                    V3Stats::addStatSum("Preprocessor cache, hits", 1);
+                    return true;
+                }
+            }
+            V3Stats::addStatSum("Preprocessor cache, misses", 1);
+        }
+        const int errorsBefore = V3Error::errorCount() + V3Error::warnCount();
+
+        UINFO(2, "    Reading " << modfilename << endl);
+        s_preprocp->openFile(fl, s_filterp, modfilename);
+        std::vector<string> lines;
         while (!s_preprocp->isEof()) {
             string line = s_preprocp->getline();
+            if (!m_cacheKey.empty()) lines.push_back(line);
             V3Parse::ppPushText(parsep, line);
         }
+        // Warnings would not be repeated when the entry is reused
+        if (!m_cacheKey.empty() && V3Error::errorCount() + V3Error::warnCount() == errorsBefore) {
+            cacheStore(defines, lines);
+        }
+        m_cacheKey.clear();
         return true;
     }
 
@@ -124,15 +163,28 @@ protected:
                        "Suggest `include with absolute path be made relative, and use +include: "
                            << modname);
         }
-        preprocOpen(fl, s_filterp, modname, V3Os::filenameDir(fl->filename()),
-                    "Cannot find include file: ");
+        const string lastpath = V3Os::filenameDir(fl->filename());
+        const string filename = preprocFind(fl, modname, lastpath, "Cannot find include file: ");
+        if (filename.empty()) return;
+        if (!m_cacheKey.empty()) {
+            string contents;
+            if (!cacheReadFile(filename, contents)) {
+                m_cacheKey.clear();  // Cannot be checked on reuse
+            } else {
+                m_cacheIncludes.push_back(modname);
+                m_cacheIncludes.push_back(lastpath);
+                m_cacheIncludes.push_back(filename);
+                m_cacheIncludes.push_back(cacheHash(contents));
+            }
+        }
+        UINFO(2, "    Reading " << filename << endl);
+        s_preprocp->openFile(fl, s_filterp, filename);
     }
 
 private:
-    string preprocOpen(FileLine* fl, VInFilter* filterp, const string& modname,
-                       const string& lastpath,
+    string preprocFind(FileLine* fl, const string& modname, const string& lastpath,
                        const string& errmsg) {  // Error message or "" to suppress
-        // Returns filename if successful
+        // Returns filename if found
         // Try a pure name in case user has a bogus `filename they don't expect
         string filename = v3Global.opt.filePath(fl, modname, lastpath, errmsg);
         if (filename == "") {
@@ -142,11 +194,181 @@ private:
 
             filename = v3Global.opt.filePath(fl, ppmodname, lastpath, errmsg);
         }
-        if (filename == "") return "";  // Not found
+        return filename;  // "" if not found
+    }
 
-        UINFO(2, "    Reading " << filename << endl);
-        s_preprocp->openFile(fl, filterp, filename);
-        return filename;
+    //---------------------------------------
+    // --pp-cache entries
+    //
+    // The key of an entry is everything the output depends on before the
+    // file is read, the entry is named by a hash of it. An entry holds a
+    // sequence of fields, each its length then its bytes: the magic, the
+    // key, the `includes to check (name, lastpath, filename, contents hash),
+    // the `define changes (kind D or U, name, params, value, cmdline), and
+    // the output chunks.
+
+    static constexpr const char* CACHE_MAGIC = "RTLflow pp-cache 2";
+
+    static string cacheHash(const string& data) {
+        vluint64_t hash = 14695981039346656037ULL;  // FNV-1a
+        for (const char c : data) hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return os.str();
+    }
+    static bool cacheReadFile(const string& filename, string& contents) {
+        std::ifstream is{filename.c_str(), std::ios::in | std::ios::binary};
+        if (!is) return false;
+        std::ostringstream os;
+        os << is.rdbuf();
+        contents = os.str();
+        return true;
+    }
+    static string cacheKey(const string& filename, const string& contents,
+                           const V3PreProc::DefineState& defines) {
+        // The version, as the output and the warnings may change with it
+        string key = V3Options::version() + '\n' + filename + '\n' + cacheHash(contents) + '\n';
+        key += v3Global.opt.fileLanguage(filename).ascii();
+        key += v3Global.opt.assertOn() ? 'A' : '-';
+        key += v3Global.opt.preprocOnly() ? 'E' : '-';
+        key += v3Global.opt.preprocNoLine() ? 'P' : '-';
+        key += v3Global.opt.ppComments() ? 'C' : '-';
+        key += v3Global.opt.lintOnly() ? 'L' : '-';
+        key += V3Error::warnFatal() ? 'F' : '-';
+        key += '\n';
+        // Warnings are reported while preprocessing, and an entry is only
+        // stored without any, so -Wall, -Wno-*, -Werror-* etc. are part of it
+        key += FileLine::defaultFileLine().m_warnOn.to_string();
+        for (int code = V3ErrorCode::EC_MIN; code < V3ErrorCode::_ENUM_MAX; ++code) {
+            key += V3Error::isError(static_cast<V3ErrorCode::en>(code), false) ? 'E' : '-';
+        }
+        key += '\n';
+        for (const auto& itr : defines) {
+            cachePut(key, itr.first);
+            cachePut(key, itr.second.m_params);
+            cachePut(key, itr.second.m_value);
+            key += itr.second.m_cmdline ? '1' : '0';
+        }
+        return key;
+    }
+    static string cacheFilename(const string& key) {
+        return v3Global.opt.ppCache() + "/" + cacheHash(key) + ".vpp";
+    }
+    static void cachePut(string& out, const string& field) {
+        out += cvtToStr(field.size()) + '\n' + field;
+    }
+    static bool cacheGet(const string& in, size_t& posr, string& field) {
+        const size_t nl = in.find('\n', posr);
+        if (nl == string::npos) return false;
+        const size_t len = std::strtoul(in.c_str() + posr, nullptr, 10);
+        if (len > in.size() - nl - 1) return false;
+        field = in.substr(nl + 1, len);
+        posr = nl + 1 + len;
+        return true;
+    }
+    static bool cacheGetCount(const string& in, size_t& posr, size_t& countr) {
+        string field;
+        if (!cacheGet(in, posr, field) || field.empty()) return false;
+        countr = std::strtoul(field.c_str(), nullptr, 10);
+        return true;
+    }
+
+    bool cacheLoad(FileLine* fl, const string& filename, V3ParseImp* parsep) {
+        string in;
+        if (!cacheReadFile(cacheFilename(m_cacheKey), in)) return false;
+        size_t pos = 0;
+        string field;
+        if (!cacheGet(in, pos, field) || field != CACHE_MAGIC) return false;
+        // Not an entry of a colliding key
+        if (!cacheGet(in, pos, field) || field != m_cacheKey) return false;
+        // The `includes must resolve to the same, unchanged, files
+        std::vector<string> depends{filename};
+        size_t count;
+        if (!cacheGetCount(in, pos, count)) return false;
+        for (size_t i = 0; i < count; ++i) {
+            string name, lastpath, incname, hash, contents;
+            if (!cacheGet(in, pos, name) || !cacheGet(in, pos, lastpath)
+                || !cacheGet(in, pos, incname) || !cacheGet(in, pos, hash)) {
+                return false;
+            }
+            if (preprocFind(fl, name, lastpath, "") != incname) return false;
+            if (!cacheReadFile(incname, contents) || cacheHash(contents) != hash) return false;
+            depends.push_back(incname);
+        }
+        std::vector<string> defines;
+        if (!cacheGetCount(in, pos, count)) return false;
+        for (size_t i = 0; i < count * 5; ++i) {
+            if (!cacheGet(in, pos, field)) return false;
+            defines.push_back(field);
+        }
+        std::vector<string> lines;
+        if (!cacheGetCount(in, pos, count)) return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (!cacheGet(in, pos, field)) return false;
+            lines.push_back(field);
+        }
+        // Hit, replay it
+        UINFO(2, "    Reusing preprocessed " << filename << endl);
+        FileLine* const deffl = new FileLine(filename);
+        for (size_t i = 0; i < defines.size(); i += 5) {
+            s_preprocp->undef(defines[i + 1]);
+            if (defines[i] == "D") {
+                s_preprocp->define(deffl, defines[i + 1], defines[i + 3], defines[i + 2],
+                                   defines[i + 4] == "1");
+            }
+        }
+        for (const string& depend : depends) V3File::addSrcDepend(depend);
+        for (const string& line : lines) V3Parse::ppPushText(parsep, line);
+        return true;
+    }
+
+    void cacheStore(const V3PreProc::DefineState& before, const std::vector<string>& lines) {
+        string out;
+        cachePut(out, CACHE_MAGIC);
+        cachePut(out, m_cacheKey);
+        cachePut(out, cvtToStr(m_cacheIncludes.size() / 4));
+        for (const string& field : m_cacheIncludes) cachePut(out, field);
+        const V3PreProc::DefineState after = s_preprocp->defineState();
+        string defines;
+        size_t count = 0;
+        for (const auto& itr : after) {
+            const auto it = before.find(itr.first);
+            if (it != before.end() && it->second == itr.second) continue;
+            cachePut(defines, "D");
+            cachePut(defines, itr.first);
+            cachePut(defines, itr.second.m_params);
+            cachePut(defines, itr.second.m_value);
+            cachePut(defines, itr.second.m_cmdline ? "1" : "0");
+            ++count;
+        }
+        for (const auto& itr : before) {
+            if (after.count(itr.first)) continue;
+            cachePut(defines, "U");
+            cachePut(defines, itr.first);
+            cachePut(defines, "");
+            cachePut(defines, "");
+            cachePut(defines, "0");
+            ++count;
+        }
+        cachePut(out, cvtToStr(count));
+        out += defines;
+        cachePut(out, cvtToStr(lines.size()));
+        for (const string& line : lines) cachePut(out, line);
+        // Write then rename, as concurrent runs may share the cache
+        V3Os::createDir(v3Global.opt.ppCache());
+        const string cachename = cacheFilename(m_cacheKey);
+        const string tmpname = cachename + "." + cvtToStr(V3Os::processId()) + "."
+                               + cvtToStr(V3Os::timeUsecs()) + ".tmp";
+        {
+            std::ofstream os{tmpname.c_str(), std::ios::out | std::ios::binary};
+            os << out;
+            if (!os) {
+                UINFO(1, "Cannot write " << tmpname << endl);
+                std::remove(tmpname.c_str());
+                return;
+            }
+        }
+        if (std::rename(tmpname.c_str(), cachename.c_str())) std::remove(tmpname.c_str());
     }
 
 public:
@@ -20,6 +20,8 @@
 #include "V3Global.h"
 #include "V3Stats.h"
 #include "V3Ast.h"
+#include "V3AstArena.h"
+#include "V3Os.h"
 
 // This visitor does not edit nodes, and is called at error-exit, so should use constant iterators
 #include "V3AstConstOnly.h"
@@ -285,4 +287,7 @@ void V3Stats::statsStageAll(AstNetlist* nodep, const string& stage, bool fast) {
 void V3Stats::statsFinalAll(AstNetlist* nodep) {
     statsStageAll(nodep, "Final");
     statsStageAll(nodep, "Final_Fast", true);
+    addStatPerf("Memory, Peak resident (MB)", V3Os::memPeakBytes() / 1024.0 / 1024.0);
+    addStatPerf("Memory, AST arena peak (MB)", V3AstArena::bytesReservedPeak() / 1024.0 / 1024.0);
+    addStatPerf("Memory, AST arena live nodes (MB)", V3AstArena::bytesLive() / 1024.0 / 1024.0);
 }
@@ -20,6 +20,7 @@
 #include "V3Global.h"
 #include "V3Stats.h"
 #include "V3Ast.h"
+#include "V3AstArena.h"
 #include "V3File.h"
 #include "V3Os.h"
 
@@ -214,6 +215,8 @@ void V3Stats::statsStage(const string& name) {
 
     double memory = V3Os::memUsageBytes() / 1024.0 / 1024.0;
     V3Stats::addStatPerf("Stage, Memory (MB), " + digitName, memory);
+    double arena = V3AstArena::bytesReserved() / 1024.0 / 1024.0;
+    V3Stats::addStatPerf("Stage, AST arena (MB), " + digitName, arena);
 }
 
 void V3Stats::statsReport() {
@@ -0,0 +1,65 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Run independent jobs on --verilate-jobs threads
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2021 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Global.h"
+#include "V3Ast.h"
+#include "V3AstArena.h"
+#include "V3ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+//######################################################################
+// V3ThreadPool class functions
+
+unsigned V3ThreadPool::threads(size_t jobs) {
+#ifdef VL_LEAK_CHECKS
+    // V3Broken tracks every node new'ed in a single map
+    return 1;
+#endif
+    // Protected names are assigned on first use, in a shared map
+    if (v3Global.opt.protectIds()) return 1;
+    unsigned threads = v3Global.opt.verilateJobs();
+    if (!threads) threads = std::max(1U, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(jobs, 1)));
+}
+
+void V3ThreadPool::run(const std::vector<Job>& jobs) {
+    const unsigned nthreads = threads(jobs.size());
+    UINFO(4, __FUNCTION__ << ": " << jobs.size() << " jobs on " << nthreads << " threads" << endl);
+    if (nthreads <= 1) {
+        for (const Job& job : jobs) job();
+        return;
+    }
+    std::atomic<size_t> next{0};
+    const auto worker = [&](bool spawned) {
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            // The calling thread keeps its counts, it may be under an AstUser#InUse
+            if (spawned) AstNode::userThreadFresh();
+            jobs[i]();
+        }
+    };
+    V3AstArena::threaded(true);
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < nthreads; ++t) workers.emplace_back(worker, true);
+    worker(false);  // The calling thread works too
+    for (std::thread& thread : workers) thread.join();
+    V3AstArena::threaded(false);
+}
@@ -0,0 +1,42 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Run independent jobs on --verilate-jobs threads
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2021 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3THREADPOOL_H_
+#define VERILATOR_V3THREADPOOL_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Error.h"
+
+#include <functional>
+#include <vector>
+
+//============================================================================
+
+class V3ThreadPool final {
+public:
+    using Job = std::function<void()>;
+    // Number of threads to use for the given number of jobs
+    static unsigned threads(size_t jobs);
+    // Run every job, on up to threads(jobs.size()) threads, and wait for all
+    // of them. Jobs are started in order, but may finish in any order, so
+    // each must only write state of its own; whatever has to be ordered, like
+    // adding nodes to the netlist, is left to the caller once run() returns.
+    static void run(const std::vector<Job>& jobs);
+};
+
+#endif  // Guard
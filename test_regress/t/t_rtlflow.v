@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Design shared by the t_rtlflow_*.pl tests of the generated batch simulator
+
+module t (/*AUTOARG*/
+   // Outputs
+   sum, any,
+   // Inputs
+   clk, in
+   );
+   input clk;
+   input [7:0] in;
+   output reg [15:0] sum;
+   output any;
+
+   integer cyc = 0;
+
+   // Single-bit internal signals, for --rtlflow-bitslice
+   reg a, b, c;
+   always @(posedge clk) begin
+      a <= in[0] ^ b;
+      b <= a & in[1];
+      c <= a | (b ^ in[2]);
+   end
+   assign any = c;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      sum <= sum + {8'h0, in};
+      if (cyc == 10) begin
+         $display("[%0t] %m sum=%0d", $time, sum);
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
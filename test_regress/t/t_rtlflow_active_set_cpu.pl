@@ -0,0 +1,27 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-backend cpu', '--rtlflow-active-set'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+# Each chunk keeps its own list of active stimuli
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/size_t\* _rf_num_active\{nullptr\};/);
+file_grep_not("$Self->{obj_dir}/rtlflow.h", qr/__device__/);
+
+ok(1);
+1;
@@ -0,0 +1,28 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--stats'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+# Every AstNode is allocated from the arena
+file_grep($Self->{stats}, qr/Memory, AST arena peak \(MB\)\s+\d+(\.\d+)?/i);
+file_grep($Self->{stats}, qr/Memory, AST arena live nodes \(MB\)\s+\d+(\.\d+)?/i);
+file_grep_not($Self->{stats}, qr/Memory, AST arena peak \(MB\)\s+0(\.0+)?\s*$/im);
+
+ok(1);
+1;
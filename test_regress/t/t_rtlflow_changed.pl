@@ -0,0 +1,32 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+compile(
+    verilator_flags2 => ['--threads 2', '--stats', '-Wno-UNOPTFLAT'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep($Self->{stats}, qr/RTLflow, change detected signals\s+[1-9]\d*/i);
+file_grep($Self->{stats}, qr/RTLflow, change detection pruned signals\s+(\d+)/i);
+# The batch iterates while any stimulus changed
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/_cudaflow.zero\(_rf_any_change, 1\);/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/0, _change_request, /);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/detect_t.precede\(end_t, sim_t\);/);
+
+my $text = join('', map { file_contents($_) } glob("$Self->{obj_dir}/*.cu"));
+$text =~ /if\(__req\) \*rfAnyChange\(_isignals\) = 1;/
+    or error("Missing batch-wide change flag");
+
+ok(1);
+1;
@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Combinational loop through the bits of one vector, so the settle loop
+// needs change detection
+
+module t (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   clk, in
+   );
+   input clk;
+   input [7:0] in;
+   output reg [7:0] out;
+
+   wire [7:0] x;
+   assign x[0] = in[0];
+   assign x[7:1] = x[6:0] ^ in[7:1];
+
+   integer cyc = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      out <= x;
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
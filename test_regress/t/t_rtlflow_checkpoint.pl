@@ -0,0 +1,31 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-backend cpu'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/#include <rf_checkpoint.h>/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void save\(const std::string& path\) const;/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void restore\(const std::string& path\);/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void restore\(const std::string& path, const std::vector<size_t>& lanes\);/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void broadcast\(const std::string& path, size_t from\);/);
+file_grep("$Self->{obj_dir}/rtlflow.cpp", qr/RfCheckpoint::save\(path, batch\(\), init\);/);
+file_grep("$Self->{obj_dir}/rtlflow.cpp", qr/void RTLflow::restored\(bool initialized\) \{/);
+
+ok(1);
+1;
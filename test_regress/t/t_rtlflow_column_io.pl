@@ -0,0 +1,35 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+# Column-oriented and streaming I/O of every pool type
+foreach my $type (qw(CData SData IData QData)) {
+    file_grep("$Self->{obj_dir}/rtlflow.h",
+              qr/void write\(${type}Loc loc, const ${type}\* column\);/);
+    file_grep("$Self->{obj_dir}/rtlflow.h", qr/void read\(${type}Loc loc, ${type}\* column\) const;/);
+    file_grep("$Self->{obj_dir}/rtlflow.h",
+              qr/void input\(${type}Loc loc, const ${type}\* columns\);/);
+    file_grep("$Self->{obj_dir}/rtlflow.h", qr/void output\(${type}Loc loc, ${type}\* columns\);/);
+}
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/void RTLflow::load\(size_t cycle\) \{/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/void RTLflow::store\(size_t cycle\) \{/);
+
+ok(1);
+1;
@@ -0,0 +1,52 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Several independent modules, constified concurrently with --verilate-jobs.
+// Each loop's break is only found unreachable once the function is inlined,
+// so a later constify must still see its JumpLabel as unused.
+
+module t (/*AUTOARG*/
+   // Outputs
+   o0, o1, o2, o3,
+   // Inputs
+   clk, in
+   );
+   input clk;
+   input [7:0] in;
+   output [3:0] o0;
+   output [3:0] o1;
+   output [3:0] o2;
+   output [3:0] o3;
+
+   sub #(.SHIFT(0)) u0 (.clk, .in, .out(o0));
+   sub #(.SHIFT(1)) u1 (.clk, .in, .out(o1));
+   sub #(.SHIFT(2)) u2 (.clk, .in, .out(o2));
+   sub #(.SHIFT(3)) u3 (.clk, .in, .out(o3));
+endmodule
+
+module sub
+  #(parameter SHIFT = 0)
+   (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   clk, in
+   );
+   /*verilator no_inline_module*/
+   input clk;
+   input [7:0] in;
+   output reg [3:0] out;
+
+   function automatic [3:0] count(input [7:0] v, input stop);
+      count = 0;
+      for (int i = 0; i < 8; i++) begin
+         if (stop && v[i]) break;
+         if (v[i]) count = count + 1;
+      end
+   endfunction
+
+   always @(posedge clk) out <= count(in >> SHIFT, 1'b0);
+endmodule
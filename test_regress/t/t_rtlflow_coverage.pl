@@ -0,0 +1,34 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--coverage-line', '--stats'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/#include <rf_coverage.h>/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void coverage_reduce\(uint32_t\* counts\) const;/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void coverage_lane\(size_t lane, uint32_t\* counts\) const;/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void coverage_zero\(\);/);
+file_grep($Self->{stats}, qr/RTLflow, coverage bins\s+[1-9]\d*/i);
+
+# Each stimulus counts in its own element of the bin's column
+my $text = join('', map { file_contents($_) } glob("$Self->{obj_dir}/*.cu"));
+$text =~ /atomicAdd\(&rfCoverage\(_isignals\)\[/
+    or error("Missing per-stimulus coverage increment");
+
+ok(1);
+1;
@@ -0,0 +1,32 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-deltas', '--converge-limit 50'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/std::vector<uint64_t> eval_deltas\(\) const;/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/std::vector<uint64_t> lane_deltas\(\) const;/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/const std::vector<size_t>& unconverged\(\) const \{ return _unconverged; \}/);
+# One histogram entry per iteration up to the limit, plus one past it
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/_rf_lane_deltas \+ 50 \+ 2\);/);
+# Unconverged stimuli are retired rather than fatal
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/_unconverged.push_back\(i\);/);
+file_grep_not("$Self->{obj_dir}/rtlflow.cu", qr/Verilated model didn't converge, stimulus/);
+
+ok(1);
+1;
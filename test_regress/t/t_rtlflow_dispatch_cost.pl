@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--stats', '--rtlflow-dispatch-cost 100'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep($Self->{stats}, qr/RTLflow, partition, mtasks\s+(\d+)/i);
+file_grep($Self->{stats}, qr/RTLflow, partition, mtasks on critical path\s+(\d+)/i);
+file_grep($Self->{stats}, qr/RTLflow, partition, predicted cycle cost\s+(\d+)/i);
+file_grep($Self->{stats}, qr/RTLflow, partition, total dispatch cost\s+(\d+)/i);
+# scoreLimit() sets the mtask count, not the --threads estimate
+file_grep_not("$Self->{obj_dir}/vlt_compile.log", qr/UNOPTTHREADS/);
+
+ok(1);
+1;
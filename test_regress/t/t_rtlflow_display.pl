@@ -0,0 +1,35 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-display'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/size_t display_drain\(\);/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void display_time\(vluint64_t time\);/);
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/std::string _name\{"TOP"\};/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/size_t RTLflow::display_drain\(\) \{/);
+
+# $display and $finish record into the per-stimulus buffer, not stdout
+my $text = join('', map { file_contents($_) } glob("$Self->{obj_dir}/*.cu"));
+$text =~ /rfDisplayRecord\(rfDisplay\(_qsignals, _isignals\), /
+    or error("Missing per-stimulus display record");
+$text !~ /VL_WRITEF/
+    or error("Unexpected VL_WRITEF in batch sources");
+
+ok(1);
+1;
@@ -0,0 +1,20 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      // Strings are not kept in the signal pools
+      $display("%s", $sformatf("cyc=%0d", cyc));
+   end
+endmodule
@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/bool all_done\(\);/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/__global__ void _rf_all_done\(const bool\* done, size_t n, IData\* all\)/);
+
+# $finish ends only its own stimulus
+my $text = join('', map { file_contents($_) } glob("$Self->{obj_dir}/*.cu"));
+$text =~ /rfDone\(_csignals\)\[\(blockDim.x \* blockIdx.x \+ threadIdx.x\)\] = true;/
+    or error("Missing per-stimulus \$finish");
+$text !~ /VL_FINISH_MT/
+    or error("Unexpected VL_FINISH_MT in batch sources");
+
+ok(1);
+1;
@@ -0,0 +1,29 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep("$Self->{obj_dir}/rtlflow.h", qr/void fork\(size_t from, size_t begin, size_t end\);/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/__global__ void _rf_fork\(/);
+# gridDim.y is capped, the kernel strides over the remaining segments
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/_rf_fork<<<dim3\(.*std::min<size_t>\(65535, rfSegments.size\(\) \+ 1\)/);
+file_grep("$Self->{obj_dir}/rtlflow.cu", qr/for\(size_t y = blockIdx.y; y <= nsegs; y \+= gridDim.y\)/);
+
+ok(1);
+1;
@@ -0,0 +1,28 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-locality', '--stats'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep($Self->{stats}, qr/RTLflow, avg lines per mtask, declaration order\s+([\d.]+)/);
+file_grep($Self->{stats}, qr/RTLflow, avg lines per mtask, locality order\s+([\d.]+)/);
+file_grep($Self->{stats}, qr/RTLflow, avg pages per mtask, declaration order\s+([\d.]+)/);
+file_grep($Self->{stats}, qr/RTLflow, avg pages per mtask, locality order\s+([\d.]+)/);
+
+ok(1);
+1;
@@ -0,0 +1,58 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+my $cache = "$Self->{obj_dir}/pp_cache";
+my $include = "$Self->{obj_dir}/t_rtlflow_pp_cache.vh";
+
+# Verilate, and keep the statistics of this run under their own name
+sub pp_cache_run {
+    my $run = shift;
+    my $define = shift;
+    compile(
+        verilator_flags2 => ["--threads 2", "--pp-cache $cache", "--stats",
+                             "+incdir+$Self->{obj_dir}",
+                             "+define+PP_DEFINE=$define"],
+        verilator_make_gmake => 0,
+        make_top_shell => 0,
+        make_main => 0,
+        );
+    my $stats = "$Self->{obj_dir}/run${run}__stats.txt";
+    rename($Self->{stats}, $stats) or error("Cannot rename $Self->{stats}");
+    return $stats;
+}
+
+sub pp_cache_hit {
+    my $stats = shift;
+    file_grep($stats, qr/Preprocessor cache, hits\s+(\d+)/, 1);
+    file_grep_not($stats, qr/Preprocessor cache, misses/);
+}
+
+sub pp_cache_miss {
+    my $stats = shift;
+    file_grep($stats, qr/Preprocessor cache, misses\s+(\d+)/, 1);
+    file_grep_not($stats, qr/Preprocessor cache, hits/);
+}
+
+write_wholefile($include, "`define PP_VALUE 1\n");
+pp_cache_miss(pp_cache_run(1, 1));
+# Nothing changed
+pp_cache_hit(pp_cache_run(2, 1));
+# The include changed
+write_wholefile($include, "`define PP_VALUE 2\n");
+pp_cache_miss(pp_cache_run(3, 1));
+pp_cache_hit(pp_cache_run(4, 1));
+# A +define+ changed
+pp_cache_miss(pp_cache_run(5, 2));
+pp_cache_hit(pp_cache_run(6, 2));
+
+ok(1);
+1;
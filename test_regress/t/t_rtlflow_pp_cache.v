@@ -0,0 +1,21 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// The include is written by t_rtlflow_pp_cache.pl into the obj_dir
+`include "t_rtlflow_pp_cache.vh"
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   always @(posedge clk) begin
+      if (`PP_VALUE + `PP_DEFINE == 0) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
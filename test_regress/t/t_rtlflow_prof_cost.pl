@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+# Hash (hex), estimated cost, measured microseconds and calls of each mtask,
+# as written by RTLflow::profile(); the hash matches no mtask of this design
+my $cost = "$Self->{obj_dir}/t_rtlflow.cost";
+write_wholefile($cost,
+                "# hash est us calls\n"
+                . "0123456789abcdef 100 12.5 10\n"
+                . "fedcba9876543210 50 0 0\n");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--stats', "--rtlflow-prof-cost $cost"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+file_grep($Self->{stats}, qr/RTLflow, mtasks with profiled cost\s+0/i);
+
+ok(1);
+1;
@@ -0,0 +1,37 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+my $cost = "$Self->{obj_dir}/t_rtlflow.cost";
+write_wholefile($cost, "0123456789abcdef 100 not_a_time 10\n");
+
+compile(
+    verilator_flags2 => ['--threads 2', "--rtlflow-prof-cost $cost"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    fails => 1,
+    expect => '%Error: Malformed line in --rtlflow-prof-cost file .*t_rtlflow.cost: 0123456789abcdef 100 not_a_time 10',
+    );
+
+compile(
+    verilator_flags2 => ['--threads 2', "--rtlflow-prof-cost $Self->{obj_dir}/does_not_exist.cost"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    fails => 1,
+    expect => '%Error: Cannot open --rtlflow-prof-cost file: .*does_not_exist.cost',
+    );
+
+ok(1);
+1;
@@ -0,0 +1,60 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Drives GPU_THREADS stimuli of t_rtlflow_run.v, each with its own inputs,
+// and checks the outputs of every stimulus against a host model
+
+#include VM_PREFIX_INCLUDE
+
+#include <cstdio>
+#include <memory>
+
+namespace RF {
+RTLflow& VM_PREFIX::_rtlflow = *new RTLflow{GPU_THREADS};
+}  // namespace RF
+
+static const size_t CYCLES = 20;
+
+static RF::CData stimulusIn(size_t lane, size_t cycle) { return (lane * 7 + cycle * 3) & 0xff; }
+
+int main(int argc, char** argv, char** env) {
+    const std::unique_ptr<RF::VerilatedContext> contextp{new RF::VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<RF::VM_PREFIX> topp{new RF::VM_PREFIX{contextp.get()}};
+    RF::RTLflow& rtlflow = RF::VM_PREFIX::_rtlflow;
+
+    // Cycle 0 resets, cycles 1 to CYCLES accumulate
+    for (size_t cycle = 0; cycle <= CYCLES; ++cycle) {
+        for (size_t lane = 0; lane < GPU_THREADS; ++lane) {
+            *rtlflow.get(topp->clk, lane) = 0;
+            *rtlflow.get(topp->rst, lane) = cycle == 0;
+            *rtlflow.get(topp->in, lane) = stimulusIn(lane, cycle);
+        }
+        topp->eval();
+        for (size_t lane = 0; lane < GPU_THREADS; ++lane) *rtlflow.get(topp->clk, lane) = 1;
+        topp->eval();
+    }
+
+    int errors = 0;
+    for (size_t lane = 0; lane < GPU_THREADS; ++lane) {
+        RF::SData sum = 0;
+        for (size_t cycle = 1; cycle <= CYCLES; ++cycle) sum += stimulusIn(lane, cycle);
+        const RF::CData parity = __builtin_parity(sum);
+        const RF::SData gotSum = *rtlflow.get(topp->sum, lane);
+        const RF::CData gotParity = *rtlflow.get(topp->parity, lane);
+        if (gotSum != sum || gotParity != parity) {
+            printf("%%Error: stimulus %zu: sum=%u parity=%u, expected sum=%u parity=%u\n", lane,
+                   gotSum, gotParity, sum, parity);
+            ++errors;
+        }
+    }
+    topp->final();
+    if (errors) return 1;
+    printf("*-* All Finished *-*\n");
+    return 0;
+}
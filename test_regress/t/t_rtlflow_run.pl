@@ -0,0 +1,32 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+
+
+# Compiles the batch with nvcc and checks every stimulus on the GPU
+if (!`which nvcc 2>/dev/null`) {
+    skip("No CUDA compiler (nvcc) installed");
+} else {
+    compile(
+        verilator_flags2 => ['--threads 2', "--exe $Self->{t_dir}/t_rtlflow_run.cpp",
+                             '-CFLAGS -DGPU_THREADS=64'],
+        make_top_shell => 0,
+        make_main => 0,
+        );
+
+    execute(
+        check_finished => 1,
+        );
+    ok(1);
+}
+
+1;
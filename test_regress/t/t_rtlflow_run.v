@@ -0,0 +1,27 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2026 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Batch simulated by t_rtlflow_run.cpp, each stimulus with its own inputs
+
+module t (/*AUTOARG*/
+   // Outputs
+   sum, parity,
+   // Inputs
+   clk, rst, in
+   );
+   input clk;
+   input rst;
+   input [7:0] in;
+   output reg [15:0] sum;
+   output parity;
+
+   assign parity = ^sum;
+
+   always @(posedge clk) begin
+      if (rst) sum <= 16'h0;
+      else sum <= sum + {8'h0, in};
+   end
+endmodule
@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+
+
+top_filename("t/t_rtlflow_run.v");
+
+# Compiles the batch with the host compiler and checks every stimulus
+compile(
+    verilator_flags2 => ['--threads 2', '--rtlflow-backend cpu',
+                         "--exe $Self->{t_dir}/t_rtlflow_run.cpp", '-CFLAGS -DGPU_THREADS=64'],
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
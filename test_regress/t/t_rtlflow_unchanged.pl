@@ -0,0 +1,43 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow.v");
+
+compile(
+    verilator_flags2 => ['--threads 2', '--no-skip-identical'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+my @files = glob("$Self->{obj_dir}/*.h $Self->{obj_dir}/*.cpp $Self->{obj_dir}/*.cu");
+@files or error("No output files found");
+my %mtimes = map { $_ => (stat($_))[9] } @files;
+
+# Rewritten files would get a later mtime; --no-skip-identical, the
+# default being on, so that the second run verilates again
+sleep(2);
+
+compile(
+    verilator_flags2 => ['--threads 2', '--no-skip-identical'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+foreach my $file (@files) {
+    (stat($file))[9] == $mtimes{$file}
+        or error("Unchanged output file was rewritten: $file");
+}
+
+ok(1);
+1;
@@ -0,0 +1,44 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2026 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("t/t_rtlflow_const_jobs.v");
+
+my $serial_dir = "$Self->{obj_dir}/serial";
+mkdir $serial_dir;
+
+compile(
+    verilator_flags2 => ['--threads 2', '--verilate-jobs 1'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+my @files = map { (split m!/!)[-1] }
+    glob("$Self->{obj_dir}/*.h $Self->{obj_dir}/*.cpp $Self->{obj_dir}/*.cu");
+foreach my $file (@files) {
+    run(cmd => ["cp", "$Self->{obj_dir}/$file", "$serial_dir/$file"]);
+}
+
+compile(
+    verilator_flags2 => ['--threads 2', '--verilate-jobs 4'],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+# Emitting on several threads must produce the same sources as on one
+foreach my $file (@files) {
+    files_identical("$Self->{obj_dir}/$file", "$serial_dir/$file");
+}
+
+ok(1);
+1;